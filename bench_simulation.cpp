@@ -0,0 +1,335 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file bench_simulation.cpp
+ * @brief Simulation-throughput benchmark of a platform across scales and topology modes.
+ *
+ * The topology a loader builds decides how fast simulations run on it. This
+ * tool scales the clusters of a JSON configuration, builds each scale in
+ * several topology modes:
+ *   - json            : libplatform.so (star zones with explicit per-node routes,
+ *                       separate up/down links, FATPIPE loopbacks, backbone)
+ *   - xml             : SimGrid <cluster> (implicit routes, SPLITDUPLEX links)
+ *   - xml-shared      : <cluster> with a single SHARED private link per node
+ *   - xml-no-loopback : <cluster> with SimGrid's default loopback
+ *   - xml-no-backbone : <cluster> without backbone
+ * and runs the synthetic workloads of synthetic_workloads.hpp on a sample of
+ * the compute hosts.
+ *
+ * Each run is a forked process. The tool reports the wall time of the load
+ * and of the simulation, the number of completed communications and I/Os
+ * (events) per second of wall time, the share of the simulation spent between
+ * the last actor blocking and the clock advancing (the model update and
+ * solver, approximately), the simulated time and the peak RSS.
+ *
+ * Usage: bench_simulation <config.json> [--scales 0.1,1] [--modes m1,m2] [--workloads w1,w2]
+ *                         [--hosts N] [--size BYTES] [--lib libplatform.so]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <simgrid/s4u.hpp>
+
+#include "config_expander.hpp"
+#include "property_sets.hpp"
+#include "synthetic_workloads.hpp"
+#include "xml_exporter.hpp"
+
+namespace sg4 = simgrid::s4u;
+using json    = nlohmann::json;
+using Clock   = std::chrono::steady_clock;
+
+const std::vector<std::string> all_modes = {"json", "xml", "xml-shared", "xml-no-loopback", "xml-no-backbone"};
+
+struct RunResult {
+  bool ok               = false;
+  bool applicable       = true; // False when the platform lacks what the workload needs
+  double load_seconds   = 0.0;
+  double run_seconds    = 0.0;
+  double solve_seconds  = 0.0;
+  double simulated_time = 0.0;
+  size_t events         = 0;
+  size_t hosts          = 0;
+  long max_rss_kb       = 0;
+};
+
+// Load the platform and run the workload in a forked child
+RunResult run_once(const std::string& platform_file, const std::string& json_config, const std::string& workload,
+                   size_t max_hosts, double size)
+{
+  RunResult result;
+  int fds[2];
+  if (pipe(fds) != 0)
+    return result;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    if (not json_config.empty())
+      setenv("PLATFORM_CONFIG", json_config.c_str(), 1);
+
+    RunResult child;
+    try {
+      std::string prog = "bench_simulation";
+      std::string log  = "--log=root.thresh:critical";
+      int argc         = 2;
+      char* argv[]     = {prog.data(), log.data(), nullptr};
+      sg4::Engine e(&argc, argv);
+
+      auto start = Clock::now();
+      e.load_platform(platform_file);
+      child.load_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      child.hosts        = e.get_host_count();
+
+      child.applicable = deploy_workload(e, workload, max_hosts, size);
+      if (child.applicable) {
+        start = Clock::now();
+        e.run();
+        child.run_seconds    = std::chrono::duration<double>(Clock::now() - start).count();
+        child.solve_seconds  = workload_stats.solve_seconds;
+        child.simulated_time = sg4::Engine::get_clock();
+        child.events         = workload_stats.events;
+      }
+      child.ok = true;
+    } catch (const std::exception& ex) {
+      std::cerr << "  " << workload << " on " << platform_file << " failed: " << ex.what() << "\n";
+    }
+    if (write(fds[1], &child, sizeof(child)) != sizeof(child))
+      _exit(2);
+    _exit(0); // Skip the engine teardown, it is not part of the measurement
+  }
+
+  close(fds[1]);
+  if (pid > 0) {
+    if (read(fds[0], &result, sizeof(result)) != sizeof(result))
+      result.ok = false;
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    result.max_rss_kb = usage.ru_maxrss;
+    if (not WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      result.ok = false;
+  }
+  close(fds[0]);
+  return result;
+}
+
+// Node ranges of a property override ("0-63,128") of a cluster of @p count nodes, mapped onto @p new_count
+// nodes: each range covers the same share of the nodes, and at least one node
+std::string scale_node_ranges(const std::string& ranges, int count, int new_count, const std::string& cluster_name)
+{
+  std::string scaled;
+  for (const auto& [first, last] : parse_node_ranges(ranges, count, cluster_name)) {
+    const int new_first = static_cast<int>(static_cast<long long>(first) * new_count / count);
+    const int new_last  = std::max(new_first, static_cast<int>((last + 1LL) * new_count / count) - 1);
+    if (not scaled.empty())
+      scaled += ',';
+    scaled += std::to_string(new_first);
+    if (new_last > new_first)
+      scaled += '-' + std::to_string(new_last);
+  }
+  return scaled;
+}
+
+// Multiply cluster sizes by @p scale, and make the configuration usable from another directory
+void scale_zones(json& zones_config, double scale, const std::filesystem::path& config_dir)
+{
+  for (auto& zone_config : zones_config) {
+    if (zone_config.contains("clusters"))
+      for (auto& cluster_cfg : zone_config["clusters"]) {
+        const int count      = cluster_cfg["count"];
+        const int new_count  = std::max(1, static_cast<int>(std::lround(count * scale)));
+        cluster_cfg["count"] = new_count;
+        // Override ranges refer to the original node count
+        if (cluster_cfg.contains("property_overrides") && new_count != count)
+          for (auto& override_cfg : cluster_cfg["property_overrides"])
+            override_cfg["nodes"] = scale_node_ranges(override_cfg["nodes"], count, new_count, cluster_cfg["name"]);
+      }
+    if (zone_config.contains("graphs"))
+      for (auto& graph_cfg : zone_config["graphs"])
+        for (const char* key : {"nodes", "edges"})
+          graph_cfg[key] = std::filesystem::absolute(config_dir / graph_cfg[key].get<std::string>()).string();
+    if (zone_config.contains("zones"))
+      scale_zones(zone_config["zones"], scale, config_dir);
+  }
+}
+
+std::vector<std::string> split_list(const std::string& list)
+{
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (not item.empty())
+      items.push_back(item);
+  return items;
+}
+
+std::string default_library_path()
+{
+  char exe[4096];
+  ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  if (len <= 0)
+    return "libplatform.so";
+  exe[len] = '\0';
+  std::string dir(exe);
+  return dir.substr(0, dir.rfind('/') + 1) + "libplatform.so";
+}
+
+void report(double scale, const std::string& mode, const std::string& workload, const RunResult& r)
+{
+  std::cout << std::setw(7) << scale << "  " << std::left << std::setw(16) << mode << std::setw(12) << workload
+            << std::right;
+  if (not r.ok) {
+    std::cout << "  failed\n";
+    return;
+  }
+  std::cout << std::setw(9) << r.hosts << std::fixed << std::setprecision(3) << std::setw(9) << r.load_seconds;
+  if (not r.applicable) {
+    std::cout << "  n/a (no suitable hosts or disks)\n" << std::defaultfloat;
+    return;
+  }
+  double rate  = r.run_seconds > 0 ? static_cast<double>(r.events) / r.run_seconds : 0.0;
+  double share = r.run_seconds > 0 ? 100.0 * r.solve_seconds / r.run_seconds : 0.0;
+  std::cout << std::setw(9) << r.run_seconds << std::setw(9) << r.events << std::setprecision(0) << std::setw(12)
+            << rate << std::setprecision(1) << std::setw(9) << share << std::setprecision(4) << std::setw(11)
+            << r.simulated_time << std::setprecision(1) << std::setw(10) << r.max_rss_kb / 1024.0 << "\n"
+            << std::defaultfloat;
+}
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " <config.json> [options]\n\n"
+            << "Measure simulation throughput on a platform at several scales and in several topology modes.\n\n"
+            << "Options:\n"
+            << "  --scales list     Cluster size factors (default: 0.1,1)\n"
+            << "  --modes list      Topology modes (default: json,xml,xml-shared,xml-no-loopback,xml-no-backbone)\n"
+            << "  --workloads list  Workloads (default: all-to-all,scatter-pfs,local-io)\n"
+            << "  --hosts N         Compute hosts taking part in the workloads (default: 64)\n"
+            << "  --size BYTES      Size of each message and I/O (default: 1e8)\n"
+            << "  --lib path        JSON loader library (default: libplatform.so next to this tool)\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::string config_path = argv[1];
+  if (config_path == "-h" || config_path == "--help") {
+    print_usage(argv[0]);
+    return 0;
+  }
+
+  std::vector<double> scales         = {0.1, 1.0};
+  std::vector<std::string> modes     = all_modes;
+  std::vector<std::string> workloads = synthetic_workloads;
+  size_t max_hosts                   = 64;
+  double size                        = 1e8;
+  std::string lib_path               = default_library_path();
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--scales") == 0 && i + 1 < argc) {
+      scales.clear();
+      for (const auto& item : split_list(argv[++i]))
+        scales.push_back(std::stod(item));
+    } else if (strcmp(argv[i], "--modes") == 0 && i + 1 < argc) {
+      modes = split_list(argv[++i]);
+    } else if (strcmp(argv[i], "--workloads") == 0 && i + 1 < argc) {
+      workloads = split_list(argv[++i]);
+    } else if (strcmp(argv[i], "--hosts") == 0 && i + 1 < argc) {
+      max_hosts = std::stoul(argv[++i]);
+    } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+      size = std::stod(argv[++i]);
+    } else if (strcmp(argv[i], "--lib") == 0 && i + 1 < argc) {
+      lib_path = argv[++i];
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+  for (const auto& mode : modes)
+    if (std::find(all_modes.begin(), all_modes.end(), mode) == all_modes.end()) {
+      std::cerr << "Unknown mode: " << mode << "\n";
+      return 1;
+    }
+  for (const auto& workload : workloads)
+    if (std::find(synthetic_workloads.begin(), synthetic_workloads.end(), workload) == synthetic_workloads.end()) {
+      std::cerr << "Unknown workload: " << workload << "\n";
+      return 1;
+    }
+
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    std::cerr << "Cannot open config file: " << config_path << "\n";
+    return 1;
+  }
+  const json config                      = expand_config(json::parse(config_file));
+  const std::filesystem::path config_dir = std::filesystem::path(config_path).parent_path();
+  const std::string tmp_base             = "/tmp/bench_simulation_" + std::to_string(getpid());
+
+  std::cout << "\n=== SIMULATION BENCHMARK: " << config_path << " (up to " << max_hosts << " hosts, " << size
+            << " bytes per message or I/O) ===\n\n"
+            << std::setw(7) << "scale" << "  " << std::left << std::setw(16) << "mode" << std::setw(12) << "workload"
+            << std::right << std::setw(9) << "hosts" << std::setw(9) << "load (s)" << std::setw(9) << "run (s)"
+            << std::setw(9) << "events" << std::setw(12) << "events/s" << std::setw(9) << "solver%" << std::setw(11)
+            << "sim time" << std::setw(10) << "RSS MB"
+            << "\n";
+
+  for (double scale : scales) {
+    json scaled = config;
+    scale_zones(scaled["facilities"], scale, config_dir);
+    // Side outputs of the loader are not wanted here
+    scaled.erase("name_map");
+    scaled.erase("topology_index");
+    const std::string json_path = tmp_base + ".json";
+    std::ofstream(json_path) << scaled.dump();
+
+    for (const auto& mode : modes) {
+      std::string platform_file = lib_path;
+      std::string json_config   = json_path;
+      if (mode != "json") {
+        XmlExportOptions options;
+        options.split_duplex = mode != "xml-shared";
+        options.loopback     = mode != "xml-no-loopback";
+        options.backbone     = mode != "xml-no-backbone";
+        platform_file        = tmp_base + ".xml";
+        json_config.clear();
+        try {
+          std::ofstream xml_file(platform_file);
+          export_xml_platform(xml_file, scaled, options);
+        } catch (const std::exception& ex) {
+          std::cout << std::setw(7) << scale << "  " << std::left << std::setw(16) << mode << std::right
+                    << "  skipped: " << ex.what() << "\n";
+          continue;
+        }
+      }
+      for (const auto& workload : workloads)
+        report(scale, mode, workload, run_once(platform_file, json_config, workload, max_hosts, size));
+    }
+  }
+  std::cout << "\n";
+
+  unlink((tmp_base + ".json").c_str());
+  unlink((tmp_base + ".xml").c_str());
+  return 0;
+}
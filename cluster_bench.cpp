@@ -0,0 +1,253 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file cluster_bench.cpp
+ * @brief Per-node cost of the cluster node kernels of cluster_builder.hpp.
+ *
+ * This tool builds a single synthetic cluster of N nodes with each node
+ * feature set used by the loader (plain nodes, node storage with or without
+ * its FSMod storage, compact names, name map, host properties copied into
+ * each host or shared in a NodePropertyTable, multiple rails), and reports
+ * what one node costs: wall time, instructions, last-level cache misses and
+ * page faults (see perf_counters.hpp), and resident memory. Each run is a
+ * forked process with a fresh SimGrid engine; the median run is reported.
+ *
+ * Multi-rail clusters have one route per ordered pair of nodes, so their rows
+ * use fixed sizes up to MAX_RAIL_NODES instead of --nodes, and include the
+ * routes added by route_rails().
+ *
+ * Usage: cluster_bench [--nodes N] [--runs N]
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+#include "cluster_builder.hpp"
+#include "perf_counters.hpp"
+
+namespace sg4 = simgrid::s4u;
+
+struct Scenario {
+  const char* label;
+  unsigned features;
+  bool shared_properties = false; // Properties in a NodePropertyTable instead of each host
+  int rail_nodes         = 0;     // With NODE_RAILS: nodes of the cluster, which has two rails
+};
+
+const std::vector<Scenario> scenarios = {
+    {"plain", 0},
+    {"storage", NODE_STORAGE | NODE_STORAGE_FS},
+    {"lazy-storage", NODE_STORAGE},
+    {"compact", NODE_STORAGE | NODE_STORAGE_FS | NODE_COMPACT},
+    {"compact+map", NODE_STORAGE | NODE_STORAGE_FS | NODE_COMPACT | NODE_NAME_MAP},
+    {"properties", NODE_STORAGE | NODE_STORAGE_FS | NODE_PROPERTIES},
+    {"shared-properties", NODE_STORAGE | NODE_STORAGE_FS | NODE_PROPERTIES, true},
+    {"rails-1024", NODE_RAILS, false, 1024},
+    {"rails-4096", NODE_RAILS, false, MAX_RAIL_NODES},
+};
+
+struct RunResult {
+  bool ok = false;
+  PerfSample perf;
+  long rss_kb = 0; // Resident memory added by the nodes
+};
+
+long current_rss_kb()
+{
+  std::ifstream statm("/proc/self/statm");
+  long pages    = 0;
+  long resident = 0;
+  statm >> pages >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Build the cluster in a forked child and collect its measurements
+RunResult run_once(const Scenario& scenario, int nodes)
+{
+  RunResult result;
+  int fds[2];
+  if (pipe(fds) != 0)
+    return result;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    RunResult child;
+    try {
+      std::string prog = "cluster_bench";
+      std::string log  = "--log=root.thresh:critical";
+      int argc         = 2;
+      char* argv[]     = {prog.data(), log.data(), nullptr};
+      sg4::Engine e(&argc, argv);
+
+      std::map<std::string, std::shared_ptr<simgrid::fsmod::Storage>> storages;
+      std::ofstream name_map("/dev/null");
+      std::vector<sg4::Host*> hosts(nodes);
+      const bool multi_rail = (scenario.features & NODE_RAILS) != 0;
+      auto* zone = multi_rail ? e.get_netzone_root()->add_netzone_full("bench")
+                              : e.get_netzone_root()->add_netzone_star("bench");
+
+      ClusterNodeContext ctx;
+      ctx.zone                    = zone;
+      ctx.backbone                = zone->add_link("bench_backbone", 1.25e9)->set_latency(1e-6);
+      ctx.prefix                  = "node-";
+      ctx.suffix                  = ".bench";
+      ctx.compact_prefix          = "~0.";
+      ctx.speed                   = 1e10;
+      ctx.cores                   = 64;
+      ctx.link_bandwidth          = 1.25e8;
+      ctx.link_latency            = 1e-6;
+      ctx.loopback_bandwidth      = 1e10;
+      ctx.loopback_latency        = 0;
+      ctx.storage_suffix          = "_local_nvme";
+      ctx.storage_read_bandwidth  = 7e9;
+      ctx.storage_write_bandwidth = 5e9;
+      ctx.storages                = &storages;
+      ctx.name_map                = &name_map;
+      ctx.hosts                   = &hosts;
+
+      // Two rails with their own backbones, as the loader builds them
+      std::vector<const sg4::Link*> rail_links;
+      if (multi_rail) {
+        for (int r = 0; r < 2; r++) {
+          const std::string name = "bench_rail" + std::to_string(r) + "_backbone";
+          ctx.rails.push_back({ctx.link_bandwidth, ctx.link_latency, zone->add_link(name, 1.25e9)->set_latency(1e-6)});
+        }
+        rail_links.resize(2 * static_cast<size_t>(nodes) * ctx.rails.size());
+        ctx.rail_links = &rail_links;
+      }
+
+      // Every other block of 1024 nodes has properties, so that kernels alternate as on real platforms
+      ClusterProperties properties;
+      if (scenario.features & NODE_PROPERTIES) {
+        properties.sets.push_back({{"rack", "r1"}, {"gpu", "a100"}, {"bios", "2.1"}, {"owner", "bench"}});
+        for (int first = 0; first < nodes; first += 2048)
+          properties.segments.push_back({first, std::min(first + 1023, nodes - 1), 0});
+      }
+
+      long rss_before = current_rss_kb();
+      PerfCounters counters;
+      counters.start();
+      NodePropertyTable shared;
+      if (scenario.shared_properties) {
+        build_nodes(ctx, nodes, scenario.features & ~NODE_PROPERTIES, ClusterProperties());
+        shared.add_cluster(0, std::move(properties));
+      } else {
+        build_nodes(ctx, nodes, scenario.features & ~NODE_PROPERTIES, properties);
+      }
+      if (multi_rail)
+        route_rails(ctx, nodes, RailPolicy::HASH, zone->add_router("bench_router"));
+      child.perf   = counters.stop();
+      child.rss_kb = current_rss_kb() - rss_before;
+      child.ok     = true;
+    } catch (const std::exception& ex) {
+      std::cerr << "  " << scenario.label << " failed: " << ex.what() << "\n";
+    }
+    if (write(fds[1], &child, sizeof(child)) != sizeof(child))
+      _exit(2);
+    _exit(0); // Skip the engine teardown, it is not part of the measurement
+  }
+
+  close(fds[1]);
+  if (pid > 0) {
+    if (read(fds[0], &result, sizeof(result)) != sizeof(result))
+      result.ok = false;
+    int status;
+    waitpid(pid, &status, 0);
+    if (not WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      result.ok = false;
+  }
+  close(fds[0]);
+  return result;
+}
+
+void report(const Scenario& scenario, std::vector<RunResult>& runs, int nodes)
+{
+  runs.erase(std::remove_if(runs.begin(), runs.end(), [](const RunResult& r) { return not r.ok; }), runs.end());
+  std::cout << std::left << std::setw(18) << scenario.label << std::right;
+  if (runs.empty()) {
+    std::cout << "  failed\n";
+    return;
+  }
+
+  std::sort(runs.begin(), runs.end(),
+            [](const RunResult& a, const RunResult& b) { return a.perf.seconds < b.perf.seconds; });
+  const auto& median = runs[runs.size() / 2];
+
+  // Unavailable counters read as -1
+  auto per_node = [nodes](double value, int precision) {
+    std::ostringstream oss;
+    if (value >= 0)
+      oss << std::fixed << std::setprecision(precision) << value / nodes;
+    else
+      oss << "n/a";
+    return oss.str();
+  };
+  std::cout << std::setw(12) << per_node(median.perf.seconds * 1e9, 0) << std::setw(14)
+            << per_node(static_cast<double>(median.perf.instructions), 0) << std::setw(14)
+            << per_node(static_cast<double>(median.perf.llc_misses), 2) << std::setw(12)
+            << per_node(static_cast<double>(median.perf.page_faults), 2) << std::setw(12)
+            << per_node(median.rss_kb * 1024.0, 0) << std::setw(6) << runs.size() << "\n";
+}
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " [--nodes N] [--runs N]\n\n"
+            << "Measure the per-node cost of building cluster nodes with each node feature set.\n\n"
+            << "Options:\n"
+            << "  --nodes N  Nodes of the synthetic cluster (default: 100000)\n"
+            << "  --runs N   Number of forked runs per feature set (default: 3)\n";
+}
+
+int main(int argc, char** argv)
+{
+  int nodes = 100000;
+  int runs  = 3;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--nodes") == 0 && i + 1 < argc) {
+      nodes = std::stoi(argv[++i]);
+    } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      runs = std::stoi(argv[++i]);
+    } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      print_usage(argv[0]);
+      return 0;
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+  if (nodes <= 0 || runs <= 0) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::cout << "\n=== CLUSTER NODE BENCHMARK: " << nodes << " nodes (" << runs << " runs, per node) ===\n\n"
+            << std::left << std::setw(18) << "features" << std::right << std::setw(12) << "ns" << std::setw(14)
+            << "instructions" << std::setw(14) << "LLC misses" << std::setw(12) << "faults" << std::setw(12)
+            << "RSS bytes" << std::setw(6) << "runs"
+            << "\n";
+
+  for (const auto& scenario : scenarios) {
+    std::vector<RunResult> results;
+    const int scenario_nodes = scenario.rail_nodes > 0 ? scenario.rail_nodes : nodes;
+    for (int i = 0; i < runs; i++)
+      results.push_back(run_once(scenario, scenario_nodes));
+    report(scenario, results, scenario_nodes);
+  }
+  std::cout << "\n";
+  return 0;
+}
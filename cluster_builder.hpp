@@ -0,0 +1,323 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file cluster_builder.hpp
+ * @brief Per-node kernels building the hosts, disks and links of a cluster zone.
+ *
+ * What a node needs (a local disk, an FSMod storage on it, compact names, a
+ * name map entry, host properties) is the same for all nodes of a cluster, or
+ * of a range of them. build_cluster_nodes() is instantiated for every set of
+ * NodeFeature bits, and build_nodes() picks the instance once per cluster (and
+ * per property segment), so that the node loop itself has no feature test.
+ * Units are parsed once into a ClusterNodeContext rather than for every node,
+ * and progress is reported once per batch of nodes.
+ * The VMs of the cluster's VM pools are created by build_vm_pool() once the
+ * nodes exist.
+ *
+ * Multi-rail clusters (NODE_RAILS) give every node a link pair on each rail.
+ * A star zone routes by endpoint only, so the rail of a pair of nodes cannot
+ * depend on both: these clusters are Full zones, and route_rails() adds one
+ * route per ordered pair of nodes on the rail chosen by the rail policy.
+ */
+
+#ifndef CLUSTER_BUILDER_HPP
+#define CLUSTER_BUILDER_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fsmod/OneDiskStorage.hpp>
+#include <simgrid/s4u.hpp>
+
+#include "load_monitor.hpp"
+#include "property_sets.hpp"
+#include "vm_pools.hpp"
+
+enum NodeFeature : unsigned {
+  NODE_STORAGE      = 1U << 0, // Node-local disk
+  NODE_STORAGE_FS   = 1U << 1, // FSMod storage created on the disk now (not lazily)
+  NODE_COMPACT      = 1U << 2, // Compact names for links, disks and storages
+  NODE_NAME_MAP     = 1U << 3, // Compact names written to the name map
+  NODE_PROPERTIES   = 1U << 4, // Host properties
+  NODE_RAILS        = 1U << 5, // One link pair per rail, routed by route_rails() (Full zone)
+  NODE_FEATURE_SETS = 1U << 6  // Number of feature combinations
+};
+
+// Private links and backbone of one rail of a multi-rail cluster
+struct RailContext {
+  double link_bandwidth;
+  double link_latency;
+  const simgrid::s4u::Link* backbone = nullptr;
+};
+
+// Rail used by the traffic of a node pair: a hash of both nodes, or the parity (index modulo rails) of the source
+enum class RailPolicy { HASH, PARITY };
+
+// Everything the node kernels need, resolved once per cluster
+struct ClusterNodeContext {
+  simgrid::s4u::NetZone* zone       = nullptr;
+  const simgrid::s4u::Link* backbone = nullptr;
+  std::string prefix;
+  std::string suffix;
+  std::string compact_prefix; // "~<cluster ordinal>."
+  double speed;
+  int cores;
+  double link_bandwidth;
+  double link_latency;
+  double loopback_bandwidth;
+  double loopback_latency;
+  std::string storage_suffix; // "_<storage name>"
+  double storage_read_bandwidth  = 0;
+  double storage_write_bandwidth = 0;
+  std::map<std::string, std::shared_ptr<simgrid::fsmod::Storage>>* storages = nullptr;
+  std::ostream* name_map                                                    = nullptr;
+  std::vector<simgrid::s4u::Host*>* hosts = nullptr; // Node i at index i, filled by the kernels
+  // With NODE_RAILS: the rails, and the links of the nodes, filled by the kernels for route_rails().
+  // The up and down links of node i on rail r are at 2 * (i * rails + r) and the next index.
+  std::vector<RailContext> rails;
+  std::vector<const simgrid::s4u::Link*>* rail_links = nullptr;
+};
+
+// Decimal digits of @p value, written to @p buffer
+template <size_t N> inline std::string_view format_index(char (&buffer)[N], size_t value)
+{
+  return {buffer, static_cast<size_t>(std::to_chars(buffer, buffer + N, value).ptr - buffer)};
+}
+
+// Name of a per-node resource: "<hostname><readable_suffix>", or "~<cluster>.<node><tag>"
+template <unsigned Features>
+inline void node_name(std::string& name, const ClusterNodeContext& ctx, const std::string& hostname,
+                      std::string_view index, std::string_view readable_suffix, char tag)
+{
+  if constexpr ((Features & NODE_COMPACT) != 0) {
+    name.assign(ctx.compact_prefix).append(index).push_back(tag);
+  } else {
+    name.assign(hostname).append(readable_suffix);
+  }
+}
+
+// Name of the link of a node on a rail: "<hostname>_rail<r><readable_suffix>", or "~<cluster>.<node><tag><r>"
+template <unsigned Features>
+inline void rail_link_name(std::string& name, const ClusterNodeContext& ctx, const std::string& hostname,
+                           std::string_view index, std::string_view rail, std::string_view readable_suffix, char tag)
+{
+  if constexpr ((Features & NODE_COMPACT) != 0) {
+    name.assign(ctx.compact_prefix).append(index).append(1, tag).append(rail);
+  } else {
+    name.assign(hostname).append("_rail").append(rail).append(readable_suffix);
+  }
+}
+
+/** Build nodes @p first to @p last (inclusive) of a cluster; @p properties is used with NODE_PROPERTIES only */
+template <unsigned Features>
+void build_cluster_nodes(const ClusterNodeContext& ctx, int first, int last, const PropertySet* properties)
+{
+  namespace sg4 = simgrid::s4u;
+  constexpr bool storage  = (Features & NODE_STORAGE) != 0;
+  constexpr bool name_map = (Features & NODE_NAME_MAP) != 0;
+
+  const std::string disk_suffix = ctx.storage_suffix + "_disk";
+  std::string hostname;
+  std::string up_name;
+  std::string down_name;
+  std::string loopback_name;
+  std::string storage_name;
+  std::string disk_name;
+  char digits[16];
+  char rail_digits[8];
+
+  for (int i = first; i <= last; i++) {
+    const std::string_view index(digits, std::to_chars(digits, digits + sizeof(digits), i).ptr - digits);
+    hostname.assign(ctx.prefix).append(index).append(ctx.suffix);
+    auto* host      = ctx.zone->add_host(hostname, ctx.speed)->set_core_count(ctx.cores);
+    (*ctx.hosts)[i] = host;
+    if constexpr ((Features & NODE_PROPERTIES) != 0)
+      host->set_properties(*properties);
+
+    if constexpr (storage) {
+      node_name<Features>(storage_name, ctx, hostname, index, ctx.storage_suffix, 's');
+      node_name<Features>(disk_name, ctx, hostname, index, disk_suffix, 'k');
+      auto* disk = host->add_disk(disk_name, ctx.storage_read_bandwidth, ctx.storage_write_bandwidth);
+      if constexpr ((Features & NODE_STORAGE_FS) != 0)
+        (*ctx.storages)[storage_name] = simgrid::fsmod::OneDiskStorage::create(storage_name, disk);
+      if constexpr (name_map)
+        *ctx.name_map << storage_name << '\t' << hostname << ctx.storage_suffix << '\n'
+                      << disk_name << '\t' << hostname << disk_suffix << '\n';
+    }
+
+    if constexpr ((Features & NODE_RAILS) != 0) {
+      // Pair routes are added by route_rails() once all nodes exist
+      for (size_t r = 0; r < ctx.rails.size(); r++) {
+        const std::string_view rail = format_index(rail_digits, r);
+        rail_link_name<Features>(up_name, ctx, hostname, index, rail, "_LinkUP", 'u');
+        rail_link_name<Features>(down_name, ctx, hostname, index, rail, "_LinkDOWN", 'd');
+        const double bandwidth = ctx.rails[r].link_bandwidth;
+        const double latency   = ctx.rails[r].link_latency;
+        const size_t slot      = 2 * (static_cast<size_t>(i) * ctx.rails.size() + r);
+
+        (*ctx.rail_links)[slot]     = ctx.zone->add_link(up_name, bandwidth)->set_latency(latency);
+        (*ctx.rail_links)[slot + 1] = ctx.zone->add_link(down_name, bandwidth)->set_latency(latency);
+        if constexpr (name_map)
+          *ctx.name_map << up_name << '\t' << hostname << "_rail" << rail << "_LinkUP\n"
+                        << down_name << '\t' << hostname << "_rail" << rail << "_LinkDOWN\n";
+      }
+    } else {
+      // Up/down as separate links for compatibility
+      node_name<Features>(up_name, ctx, hostname, index, "_LinkUP", 'u');
+      node_name<Features>(down_name, ctx, hostname, index, "_LinkDOWN", 'd');
+      auto* link_up   = ctx.zone->add_link(up_name, ctx.link_bandwidth)->set_latency(ctx.link_latency);
+      auto* link_down = ctx.zone->add_link(down_name, ctx.link_bandwidth)->set_latency(ctx.link_latency);
+      if constexpr (name_map)
+        *ctx.name_map << up_name << '\t' << hostname << "_LinkUP\n"
+                      << down_name << '\t' << hostname << "_LinkDOWN\n";
+      ctx.zone->add_route(host, nullptr, {sg4::LinkInRoute(link_up), sg4::LinkInRoute(ctx.backbone)}, false);
+      ctx.zone->add_route(nullptr, host, {sg4::LinkInRoute(ctx.backbone), sg4::LinkInRoute(link_down)}, false);
+    }
+
+    node_name<Features>(loopback_name, ctx, hostname, index, "_loopback", 'l');
+    auto* loopback = ctx.zone->add_link(loopback_name, ctx.loopback_bandwidth)
+                         ->set_latency(ctx.loopback_latency)
+                         ->set_sharing_policy(sg4::Link::SharingPolicy::FATPIPE);
+    if constexpr (name_map)
+      *ctx.name_map << loopback_name << '\t' << hostname << "_loopback\n";
+    ctx.zone->add_route(host, host, {loopback});
+  }
+}
+
+using NodeKernel = void (*)(const ClusterNodeContext&, int, int, const PropertySet*);
+
+template <size_t... Features>
+constexpr std::array<NodeKernel, sizeof...(Features)> make_node_kernels(std::index_sequence<Features...>)
+{
+  return {&build_cluster_nodes<static_cast<unsigned>(Features)>...};
+}
+
+/** Instance of build_cluster_nodes() for a set of NodeFeature bits */
+inline NodeKernel node_kernel(unsigned features)
+{
+  static constexpr auto kernels = make_node_kernels(std::make_index_sequence<NODE_FEATURE_SETS>());
+  return kernels[features];
+}
+
+// Nodes built between two progress updates. The kernels leave progress to build_node_range(), so that the node
+// loop does not call into load_monitor; batches as large as its check stride (256) keep budgets as responsive.
+constexpr int NODE_BATCH = 256;
+
+/** Build nodes @p first to @p last (inclusive) with @p kernel, reporting progress once per NODE_BATCH nodes */
+inline void build_node_range(NodeKernel kernel, const ClusterNodeContext& ctx, int first, int last,
+                             const PropertySet* properties)
+{
+  for (int batch = first; batch <= last; batch += NODE_BATCH) {
+    const int batch_last = std::min(batch + NODE_BATCH - 1, last);
+    kernel(ctx, batch, batch_last, properties);
+    load_monitor.advance(static_cast<size_t>(batch_last - batch + 1));
+  }
+}
+
+/** Build all the nodes of a cluster, switching kernels at the boundaries of its property segments */
+inline void build_nodes(const ClusterNodeContext& ctx, int count, unsigned features, const ClusterProperties& properties)
+{
+  const NodeKernel plain     = node_kernel(features & ~NODE_PROPERTIES);
+  const NodeKernel with_sets = node_kernel(features | NODE_PROPERTIES);
+  int next                   = 0;
+  for (const auto& segment : properties.segments) {
+    if (segment.first > next)
+      build_node_range(plain, ctx, next, segment.first - 1, nullptr);
+    build_node_range(with_sets, ctx, segment.first, segment.last, &properties.sets[segment.set]);
+    next = segment.last + 1;
+  }
+  if (next < count)
+    build_node_range(plain, ctx, next, count - 1, nullptr);
+}
+
+/** Rail of the traffic from node @p src to node @p dst */
+inline size_t rail_of(RailPolicy policy, size_t rails, int src, int dst)
+{
+  if (policy == RailPolicy::PARITY)
+    return static_cast<size_t>(src) % rails;
+  // Symmetric, so that both directions of a pair share a rail, and mixed, so that neighbours spread out
+  uint64_t key = static_cast<uint64_t>(std::min(src, dst)) << 32 | static_cast<uint32_t>(std::max(src, dst));
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return static_cast<size_t>(key % rails);
+}
+
+/**
+ * Largest multi-rail cluster. Its Full zone holds count * (count - 1) routes of three links: at this size about
+ * 16.8 million routes and 50 million link references. The rails-1024 and rails-4096 rows of cluster_bench measure
+ * what they cost to build; larger clusters are rejected at load time.
+ */
+constexpr int MAX_RAIL_NODES = 4096;
+
+/**
+ * Routes of a multi-rail cluster built with NODE_RAILS: every ordered pair of nodes on its rail, through the
+ * source's up link, the rail's backbone and the destination's down link, and node i to and from @p gateway
+ * on the rail that @p policy gives to node i and the gateway, taken as node count. This is count * (count - 1)
+ * routes, see MAX_RAIL_NODES.
+ */
+inline void route_rails(const ClusterNodeContext& ctx, int count, RailPolicy policy,
+                        simgrid::kernel::routing::NetPoint* gateway)
+{
+  namespace sg4      = simgrid::s4u;
+  const size_t rails = ctx.rails.size();
+  const auto& links  = *ctx.rail_links;
+  auto up            = [&links, rails](int node, size_t rail) { return links[2 * (node * rails + rail)]; };
+  auto down          = [&links, rails](int node, size_t rail) { return links[2 * (node * rails + rail) + 1]; };
+
+  std::vector<sg4::LinkInRoute> route;
+  for (int src = 0; src < count; src++) {
+    auto* src_point = (*ctx.hosts)[src]->get_netpoint();
+    for (int dst = 0; dst < count; dst++) {
+      if (dst == src)
+        continue;
+      const size_t rail = rail_of(policy, rails, src, dst);
+      route             = {sg4::LinkInRoute(up(src, rail)), sg4::LinkInRoute(ctx.rails[rail].backbone),
+                           sg4::LinkInRoute(down(dst, rail))};
+      ctx.zone->add_route(src_point, (*ctx.hosts)[dst]->get_netpoint(), nullptr, nullptr, route, false);
+    }
+    const size_t rail = rail_of(policy, rails, src, count);
+    route             = {sg4::LinkInRoute(up(src, rail)), sg4::LinkInRoute(ctx.rails[rail].backbone)};
+    ctx.zone->add_route(src_point, gateway, nullptr, nullptr, route, false);
+    route = {sg4::LinkInRoute(ctx.rails[rail].backbone), sg4::LinkInRoute(down(src, rail))};
+    ctx.zone->add_route(gateway, src_point, nullptr, nullptr, route, false);
+  }
+}
+
+/** Create the VMs of @p pool on the @p count nodes of a cluster, appending them to @p vms node after node */
+inline void build_vm_pool(const ClusterNodeContext& ctx, int count, const VmPoolConfig& pool,
+                          std::vector<simgrid::s4u::VirtualMachine*>& vms)
+{
+  vms.reserve(vms.size() + static_cast<size_t>(count) * pool.per_host);
+  std::string vm_name;
+  char node_digits[16];
+  char vm_digits[16];
+  for (int i = 0; i < count; i++) {
+    auto* host                  = (*ctx.hosts)[i];
+    const std::string& hostname = host->get_name();
+    const std::string_view node = format_index(node_digits, i);
+    for (int v = 0; v < pool.per_host; v++) {
+      pool.vm_name(vm_name, hostname, node, format_index(vm_digits, v));
+      auto* machine = pool.ramsize > 0 ? host->create_vm(vm_name, pool.cores, pool.ramsize)
+                                       : host->create_vm(vm_name, pool.cores);
+      if (pool.start)
+        machine->start();
+      vms.push_back(machine);
+    }
+    load_monitor.advance(pool.per_host);
+  }
+}
+
+#endif
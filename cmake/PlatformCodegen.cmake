@@ -0,0 +1,51 @@
+# Helpers to compile JSON platform configurations ahead of time with platform_codegen.
+
+# Copyright (c) 2026. The SWAT Team. All rights reserved.
+#
+# This file is free software; you can redistribute it and/or modify it
+# under the terms of the license (GNU LGPL) which comes with this package.
+
+#
+#  platform_codegen_generate(<output.cpp> <config.json> [SYMBOL <name>])
+#
+#    Generate <output.cpp> from <config.json>. The generated function is named
+#    load_platform unless SYMBOL is given. The file is regenerated whenever the
+#    configuration or platform_codegen itself changes, so the JSON file remains
+#    the source of truth.
+#
+#  add_platform_library(<target> <config.json>)
+#
+#    Build a shared library lib<target>.so exposing load_platform() for the
+#    given configuration. It can be used in place of libplatform.so:
+#       ./your_simulator --cfg=platf:/path/to/lib<target>.so
+#
+
+function(platform_codegen_generate output config)
+  cmake_parse_arguments(ARG "" "SYMBOL" "" ${ARGN})
+  if (NOT ARG_SYMBOL)
+    set(ARG_SYMBOL load_platform)
+  endif()
+
+  add_custom_command(
+    OUTPUT ${output}
+    COMMAND platform_codegen ${config} -o ${output} --symbol ${ARG_SYMBOL}
+    DEPENDS platform_codegen ${config}
+    COMMENT "Generating C++ platform from ${config}"
+    VERBATIM
+  )
+endfunction()
+
+function(add_platform_library target config)
+  set(generated ${CMAKE_CURRENT_BINARY_DIR}/${target}_generated.cpp)
+  platform_codegen_generate(${generated} ${config})
+
+  add_library(${target} SHARED ${generated})
+  target_include_directories(${target} PRIVATE
+    ${SimGrid_INCLUDE_DIR}
+    ${FSMOD_INCLUDE_DIR}
+  )
+  target_link_libraries(${target} PRIVATE
+    SimGrid::SimGrid
+    FSMOD::FSMOD
+  )
+endfunction()
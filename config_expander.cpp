@@ -0,0 +1,151 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <cctype>
+#include <stdexcept>
+#include <string>
+
+#include "config_expander.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int max_template_depth = 16;
+
+class ConfigExpander {
+  const json& templates_;
+
+  // The object with its template, and the templates of that one, merged in
+  json resolve_template(const json& object, int depth) const
+  {
+    const std::string name = object["template"];
+    if (depth >= max_template_depth)
+      throw std::runtime_error("Template '" + name + "' nests too deep (loop?)");
+    if (not templates_.contains(name))
+      throw std::runtime_error("Unknown template '" + name + "'");
+
+    json result = templates_[name];
+    if (result.contains("template"))
+      result = resolve_template(result, depth + 1);
+    json patch = object;
+    patch.erase("template");
+    result.merge_patch(patch);
+    return result;
+  }
+
+  // Replace "{var}", "{var+N}", "{var-N}" and their ":W" zero-padded forms by their value for @p value
+  static std::string substitute(const std::string& text, const std::string& var, long value)
+  {
+    std::string result;
+    size_t pos = 0;
+    while (pos < text.size()) {
+      size_t open = text.find('{', pos);
+      if (open == std::string::npos || text.compare(open + 1, var.size(), var) != 0) {
+        size_t next = open == std::string::npos ? text.size() : open + 1;
+        result.append(text, pos, next - pos);
+        pos = next;
+        continue;
+      }
+      size_t cur  = open + 1 + var.size();
+      long offset = 0;
+      int width   = 0;
+      if (cur < text.size() && (text[cur] == '+' || text[cur] == '-')) {
+        size_t digits = cur + 1;
+        while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits])))
+          digits++;
+        if (digits == cur + 1) {
+          result.append(text, pos, cur - pos);
+          pos = cur;
+          continue;
+        }
+        offset = std::stol(text.substr(cur, digits - cur));
+        cur    = digits;
+      }
+      if (cur < text.size() && text[cur] == ':') {
+        size_t digits = cur + 1;
+        while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits])))
+          digits++;
+        if (digits == cur + 1) {
+          result.append(text, pos, cur - pos);
+          pos = cur;
+          continue;
+        }
+        width = std::stoi(text.substr(cur + 1, digits - cur - 1));
+        cur   = digits;
+      }
+      if (cur >= text.size() || text[cur] != '}') { // Not a placeholder of this variable
+        result.append(text, pos, open + 1 - pos);
+        pos = open + 1;
+        continue;
+      }
+      std::string number = std::to_string(value + offset);
+      if (static_cast<int>(number.size()) < width)
+        number.insert(number[0] == '-' ? 1 : 0, width - number.size(), '0');
+      result.append(text, pos, open - pos).append(number);
+      pos = cur + 1;
+    }
+    return result;
+  }
+
+  static void substitute_all(json& node, const std::string& var, long value)
+  {
+    if (node.is_string()) {
+      node = substitute(node.get<std::string>(), var, value);
+    } else if (node.is_structured()) {
+      for (auto& child : node)
+        substitute_all(child, var, value);
+    }
+  }
+
+public:
+  explicit ConfigExpander(const json& templates) : templates_(templates) {}
+
+  void expand(json& node) const
+  {
+    if (node.is_object()) {
+      if (node.contains("template"))
+        node = resolve_template(node, 0);
+      for (auto& child : node)
+        expand(child);
+    } else if (node.is_array()) {
+      json expanded = json::array();
+      for (auto& element : node) {
+        if (element.is_object() && element.contains("template"))
+          element = resolve_template(element, 0);
+        if (not element.is_object() || not element.contains("repeat")) {
+          expand(element);
+          expanded.push_back(std::move(element));
+          continue;
+        }
+        const json repeat     = element["repeat"];
+        const long count      = repeat.at("count").get<long>();
+        const long start      = repeat.value("start", 0L);
+        const std::string var = repeat.value("var", "i");
+        if (count < 0)
+          throw std::runtime_error("Negative repeat count");
+        element.erase("repeat");
+        for (long k = 0; k < count; k++) {
+          json copy = element;
+          substitute_all(copy, var, start + k);
+          expand(copy);
+          expanded.push_back(std::move(copy));
+        }
+      }
+      node = std::move(expanded);
+    }
+  }
+};
+
+} // namespace
+
+json expand_config(const json& config)
+{
+  const json templates = config.value("templates", json::object());
+  json result          = config;
+  result.erase("templates");
+  ConfigExpander(templates).expand(result);
+  return result;
+}
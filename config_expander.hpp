@@ -0,0 +1,38 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file config_expander.hpp
+ * @brief Expansion of the shared definitions and repeat constructs of a configuration.
+ *
+ * Two constructs keep large configurations short:
+ *
+ *   "templates": {"rack": {"count": 64, "node": {...}, ...}}
+ *   {"template": "rack", "name": "rack3", "prefix": "r3n"}
+ *
+ * An object naming a template is the template merged with the object's own
+ * keys (a JSON merge patch: nested objects are merged, a null value removes a
+ * key of the template). Templates may themselves name a template.
+ *
+ *   {"repeat": {"count": 16, "start": 1}, "name": "rack{i}", "prefix": "r{i:02}n"}
+ *
+ * A list element with "repeat" stands for "count" copies of itself, where
+ * "{i}" in any string is replaced by start, start + 1, ... ("start" defaults
+ * to 0). "{i+1}" and "{i-1}" add an offset, "{i:02}" pads with zeros to two
+ * digits, and "var" names the variable, so that repeats can be nested.
+ *
+ * The loader and every tool reading configurations expand them first, so the
+ * rest of the code only sees explicit configurations.
+ */
+
+#ifndef CONFIG_EXPANDER_HPP
+#define CONFIG_EXPANDER_HPP
+
+#include <nlohmann/json.hpp>
+
+/** @p config with its templates applied and its repeats unrolled; throws std::runtime_error on misuse */
+nlohmann::json expand_config(const nlohmann::json& config);
+
+#endif
@@ -0,0 +1,272 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph_zone.hpp"
+
+namespace sg4 = simgrid::s4u;
+using json    = nlohmann::json;
+
+namespace {
+
+constexpr char EDGES_MAGIC[8] = {'P', 'G', 'E', 'D', 'G', 'E', 'S', '1'};
+constexpr size_t EDGES_HEADER = sizeof(EDGES_MAGIC) + sizeof(uint64_t); // Magic and edge count
+constexpr size_t EDGE_RECORD  = 3 * sizeof(uint32_t);
+
+// Little-endian unsigned integer at @p bytes, whatever the byte order of the host
+template <typename T> T read_le(const char* bytes)
+{
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++)
+    value |= static_cast<T>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+  return value;
+}
+
+// Read-only mapping of a whole file, so that names can be used in place as string_views
+class MappedFile {
+  void* data_  = nullptr;
+  size_t size_ = 0;
+
+public:
+  explicit MappedFile(const std::string& path)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Cannot open graph file: " + path);
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+      size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+      data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data_ == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Cannot map graph file: " + path);
+      }
+      madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    close(fd);
+  }
+  MappedFile(const MappedFile&)            = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile()
+  {
+    if (size_ > 0)
+      munmap(data_, size_);
+  }
+
+  std::string_view view() const { return {static_cast<const char*>(data_), size_}; }
+};
+
+// Call f(tokens, line_number) for each non-empty, non-comment line of text
+template <typename F> void for_each_line(std::string_view text, F&& f)
+{
+  std::vector<std::string_view> tokens;
+  size_t line_number = 0;
+  while (not text.empty()) {
+    size_t eol            = text.find('\n');
+    std::string_view line = text.substr(0, eol);
+    text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+    line_number++;
+
+    tokens.clear();
+    size_t pos = 0;
+    while (pos < line.size()) {
+      while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r'))
+        pos++;
+      if (pos == line.size() || line[pos] == '#')
+        break;
+      size_t end = pos;
+      while (end < line.size() && line[end] != ' ' && line[end] != '\t' && line[end] != '\r')
+        end++;
+      tokens.push_back(line.substr(pos, end - pos));
+      pos = end;
+    }
+    if (not tokens.empty())
+      f(tokens, line_number);
+  }
+}
+
+struct GraphBuilder {
+  sg4::NetZone* zone;
+  std::string nodes_path;
+  std::string edges_path;
+  std::vector<sg4::Host*>* hosts = nullptr;
+
+  std::vector<simgrid::kernel::routing::NetPoint*> vertices;
+  std::vector<const sg4::Link*> links;
+  std::unordered_map<std::string_view, size_t> vertex_index;
+  std::unordered_map<std::string_view, size_t> link_index;
+
+  GraphBuilder(sg4::NetZone* zone, std::string nodes_path, std::string edges_path)
+      : zone(zone), nodes_path(std::move(nodes_path)), edges_path(std::move(edges_path))
+  {
+  }
+
+  [[noreturn]] static void fail(const std::string& path, size_t line_number, const std::string& what)
+  {
+    throw std::runtime_error(path + ":" + std::to_string(line_number) + ": " + what);
+  }
+
+  void read_nodes(std::string_view text)
+  {
+    for_each_line(text, [this](const std::vector<std::string_view>& tokens, size_t line_number) {
+      const std::string_view kind = tokens[0];
+      if (tokens.size() < 2)
+        fail(nodes_path, line_number, "missing name");
+      const std::string_view name = tokens[1];
+
+      if (kind == "host") {
+        if (tokens.size() < 3)
+          fail(nodes_path, line_number, "host needs a speed");
+        auto* host = zone->add_host(std::string(name), std::string(tokens[2]));
+        if (tokens.size() > 3) {
+          int cores            = 0;
+          const char* end      = tokens[3].data() + tokens[3].size();
+          const auto [ptr, ec] = std::from_chars(tokens[3].data(), end, cores);
+          if (ec != std::errc() || ptr != end || cores < 1)
+            fail(nodes_path, line_number, "invalid core count '" + std::string(tokens[3]) + "'");
+          host->set_core_count(cores);
+        }
+        if (hosts)
+          hosts->push_back(host);
+        add_vertex(name, host->get_netpoint(), line_number);
+      } else if (kind == "router") {
+        add_vertex(name, zone->add_router(std::string(name)), line_number);
+      } else if (kind == "link") {
+        if (tokens.size() < 3)
+          fail(nodes_path, line_number, "link needs a bandwidth");
+        auto* link = zone->add_link(std::string(name), std::string(tokens[2]));
+        if (tokens.size() > 3)
+          link->set_latency(std::string(tokens[3]));
+        if (tokens.size() > 4) {
+          if (tokens[4] == "FATPIPE")
+            link->set_sharing_policy(sg4::Link::SharingPolicy::FATPIPE);
+          else if (tokens[4] != "SHARED")
+            fail(nodes_path, line_number, "unsupported sharing policy '" + std::string(tokens[4]) + "'");
+        }
+        if (not link_index.emplace(name, links.size()).second)
+          fail(nodes_path, line_number, "duplicate link '" + std::string(name) + "'");
+        links.push_back(link);
+      } else {
+        fail(nodes_path, line_number, "unknown entry '" + std::string(kind) + "'");
+      }
+    });
+  }
+
+  void add_vertex(std::string_view name, simgrid::kernel::routing::NetPoint* netpoint, size_t line_number)
+  {
+    if (not vertex_index.emplace(name, vertices.size()).second)
+      fail(nodes_path, line_number, "duplicate vertex '" + std::string(name) + "'");
+    vertices.push_back(netpoint);
+  }
+
+  void add_edge(size_t src, size_t dst, size_t link)
+  {
+    zone->add_route(vertices[src], vertices[dst], nullptr, nullptr, {sg4::LinkInRoute(links[link])}, true);
+  }
+
+  void read_text_edges(std::string_view text)
+  {
+    auto lookup = [this](const std::unordered_map<std::string_view, size_t>& index, std::string_view name,
+                         size_t line_number) {
+      auto it = index.find(name);
+      if (it == index.end())
+        fail(edges_path, line_number, "unknown name '" + std::string(name) + "'");
+      return it->second;
+    };
+    for_each_line(text, [this, &lookup](const std::vector<std::string_view>& tokens, size_t line_number) {
+      if (tokens.size() != 3)
+        fail(edges_path, line_number, "expected '<src> <dst> <link>'");
+      add_edge(lookup(vertex_index, tokens[0], line_number), lookup(vertex_index, tokens[1], line_number),
+               lookup(link_index, tokens[2], line_number));
+    });
+  }
+
+  // Binary files have no lines: errors give the byte offset of the faulty header or record
+  [[noreturn]] static void fail_at(const std::string& path, size_t offset, const std::string& what)
+  {
+    throw std::runtime_error(path + ": byte " + std::to_string(offset) + ": " + what);
+  }
+
+  void read_binary_edges(std::string_view data)
+  {
+    if (data.size() < EDGES_HEADER)
+      fail_at(edges_path, sizeof(EDGES_MAGIC), "truncated edge count");
+    const uint64_t count   = read_le<uint64_t>(data.data() + sizeof(EDGES_MAGIC));
+    const uint64_t records = (data.size() - EDGES_HEADER) / EDGE_RECORD;
+    if (records < count)
+      fail_at(edges_path, EDGES_HEADER + records * EDGE_RECORD,
+              "truncated edge #" + std::to_string(records) + " of " + std::to_string(count));
+
+    for (uint64_t i = 0; i < count; i++) {
+      const char* record  = data.data() + EDGES_HEADER + i * EDGE_RECORD;
+      const uint32_t src  = read_le<uint32_t>(record);
+      const uint32_t dst  = read_le<uint32_t>(record + sizeof(uint32_t));
+      const uint32_t link = read_le<uint32_t>(record + 2 * sizeof(uint32_t));
+      if (src >= vertices.size() || dst >= vertices.size() || link >= links.size())
+        fail_at(edges_path, EDGES_HEADER + i * EDGE_RECORD,
+                "edge #" + std::to_string(i) + " references an unknown vertex or link");
+      add_edge(src, dst, link);
+    }
+  }
+};
+
+} // namespace
+
+sg4::NetZone* create_graph_zone(sg4::NetZone* parent, const json& graph_config, const std::filesystem::path& base_dir,
+                                std::vector<sg4::Host*>* hosts)
+{
+  const std::string name    = graph_config["name"];
+  const std::string routing = graph_config.value("routing", "Dijkstra");
+
+  sg4::NetZone* zone;
+  if (routing == "Dijkstra") {
+    zone = parent->add_netzone_dijkstra(name, true);
+  } else if (routing == "Floyd") {
+    zone = parent->add_netzone_floyd(name);
+  } else {
+    throw std::runtime_error("Unsupported routing '" + routing + "' for graph zone " + name);
+  }
+
+  GraphBuilder builder(zone, (base_dir / graph_config["nodes"].get<std::string>()).string(),
+                       (base_dir / graph_config["edges"].get<std::string>()).string());
+  builder.hosts = hosts;
+
+  // The node file stays mapped while edges are read, since the name indexes point into it
+  MappedFile nodes(builder.nodes_path);
+  builder.read_nodes(nodes.view());
+
+  MappedFile edges(builder.edges_path);
+  std::string_view edge_data = edges.view();
+  if (edge_data.size() >= sizeof(EDGES_MAGIC) && std::memcmp(edge_data.data(), EDGES_MAGIC, sizeof(EDGES_MAGIC)) == 0)
+    builder.read_binary_edges(edge_data);
+  else
+    builder.read_text_edges(edge_data);
+
+  // Without a gateway the zone can only be used for communications among its own hosts
+  if (graph_config.contains("gateway")) {
+    const std::string gateway = graph_config["gateway"];
+    auto it                   = builder.vertex_index.find(gateway);
+    if (it == builder.vertex_index.end())
+      throw std::runtime_error("Gateway '" + gateway + "' of graph zone " + name + " is not in " + builder.nodes_path);
+    zone->set_gateway(builder.vertices[it->second]);
+  }
+
+  zone->seal();
+  return zone;
+}
@@ -0,0 +1,47 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file graph_zone.hpp
+ * @brief Zones with arbitrary topology read from external node and edge files.
+ *
+ * The node file is a text file with one vertex or link per line:
+ *
+ *     host   <name> <speed> [<cores>]
+ *     router <name>
+ *     link   <name> <bandwidth> [<latency>] [SHARED|FATPIPE]
+ *
+ * The edge file connects two vertices through a link, either as text lines
+ * (`<src> <dst> <link>`) or in the binary format below, detected by its magic:
+ *
+ *     char     magic[8] = "PGEDGES1"
+ *     uint64_t count
+ *     count x { uint32_t src_vertex, dst_vertex, link }   (little endian)
+ *
+ * where vertices (hosts and routers) and links are indexed in their order of
+ * appearance in the node file, and integers are decoded as little endian on
+ * any host. Errors give the line of text files and the byte offset in binary
+ * edge files. Both files are memory-mapped and parsed in place, and routes
+ * are computed by a Dijkstra (default) or Floyd zone.
+ */
+
+#ifndef GRAPH_ZONE_HPP
+#define GRAPH_ZONE_HPP
+
+#include <filesystem>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <simgrid/s4u.hpp>
+
+/** Create the graph zone described by @p graph_config as a child of @p parent.
+ *  Relative file names are resolved from @p base_dir. When @p hosts is given, the hosts are appended to it
+ *  in node file order. */
+simgrid::s4u::NetZone* create_graph_zone(simgrid::s4u::NetZone* parent, const nlohmann::json& graph_config,
+                                         const std::filesystem::path& base_dir,
+                                         std::vector<simgrid::s4u::Host*>* hosts = nullptr);
+
+#endif
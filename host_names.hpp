@@ -0,0 +1,119 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file host_names.hpp
+ * @brief Name-to-host table of the loader, behind lookup_host().
+ *
+ * Cluster nodes are named prefix + index + suffix, so their names are not
+ * hashed: a lookup splits the name at the start of each run of digits,
+ * finds the clusters with that prefix by binary search, compares the suffix
+ * and parses the index, which gives the host by position. Other hosts
+ * (storage servers, graph zone hosts, VMs) and nodes whose names cannot be
+ * split unambiguously (a prefix ending or a suffix starting with a digit)
+ * go to a hash table keyed by views of the names SimGrid stores, so that
+ * lookups never build a std::string.
+ *
+ * Every host has a position, in the order it was added, which the loader uses
+ * to find the shared property set of a cluster node (see NodePropertyTable).
+ */
+
+#ifndef HOST_NAMES_HPP
+#define HOST_NAMES_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+class HostNameTable {
+  struct Pattern {
+    std::string prefix;
+    std::string suffix;
+    size_t first; // Node 0 in hosts_
+    size_t count;
+  };
+  std::vector<Pattern> patterns_; // Sorted by prefix
+  std::vector<simgrid::s4u::Host*> hosts_;
+  std::unordered_map<std::string_view, size_t> others_; // Positions in hosts_
+
+  static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+  size_t find_node(std::string_view name, size_t start) const
+  {
+    size_t end = start;
+    while (end < name.size() && is_digit(name[end]))
+      end++;
+    // Generated indices have no leading zero
+    if (end - start > 1 && name[start] == '0')
+      return npos;
+    size_t index         = 0;
+    const auto [ptr, ec] = std::from_chars(name.data() + start, name.data() + end, index);
+    if (ec != std::errc() || ptr != name.data() + end)
+      return npos;
+
+    const std::string_view prefix = name.substr(0, start);
+    const std::string_view suffix = name.substr(end);
+    auto it = std::lower_bound(patterns_.begin(), patterns_.end(), prefix,
+                               [](const Pattern& p, std::string_view n) { return p.prefix < n; });
+    for (; it != patterns_.end() && it->prefix == prefix; ++it)
+      if (it->suffix == suffix && index < it->count)
+        return it->first + index;
+    return npos;
+  }
+
+public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /** Nodes of a cluster, node i named prefix + i + suffix at hosts[i]; returns the position of node 0 */
+  size_t add_cluster(const std::string& prefix, const std::string& suffix,
+                     const std::vector<simgrid::s4u::Host*>& hosts)
+  {
+    const size_t first = hosts_.size();
+    if ((not prefix.empty() && is_digit(prefix.back())) || (not suffix.empty() && is_digit(suffix.front()))) {
+      for (auto* host : hosts)
+        add_host(host);
+      return first;
+    }
+    auto it = std::upper_bound(patterns_.begin(), patterns_.end(), prefix,
+                               [](const std::string& n, const Pattern& p) { return n < p.prefix; });
+    patterns_.insert(it, {prefix, suffix, first, hosts.size()});
+    hosts_.insert(hosts_.end(), hosts.begin(), hosts.end());
+    return first;
+  }
+
+  /** Returns the position of @p host */
+  size_t add_host(simgrid::s4u::Host* host)
+  {
+    others_.emplace(host->get_name(), hosts_.size());
+    hosts_.push_back(host);
+    return hosts_.size() - 1;
+  }
+
+  /** Position of the host named @p name, or npos */
+  size_t position(std::string_view name) const
+  {
+    if (not patterns_.empty())
+      for (size_t i = 0; i < name.size(); i++)
+        if (is_digit(name[i]) && (i == 0 || not is_digit(name[i - 1])))
+          if (size_t pos = find_node(name, i); pos != npos)
+            return pos;
+    auto it = others_.find(name);
+    return it == others_.end() ? npos : it->second;
+  }
+
+  /** Host named @p name, or nullptr */
+  simgrid::s4u::Host* find(std::string_view name) const
+  {
+    const size_t pos = position(name);
+    return pos == npos ? nullptr : hosts_[pos];
+  }
+};
+
+#endif
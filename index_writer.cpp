@@ -0,0 +1,378 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <xbt/parse_units.hpp>
+
+#include "index_writer.hpp"
+#include "property_sets.hpp"
+#include "topology_index.hpp"
+#include "vm_pools.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+class IndexBuilder {
+  std::string strings_;
+  std::vector<IndexZone> zones_;
+  std::vector<IndexCluster> clusters_;
+  std::vector<IndexHost> hosts_;
+  std::vector<IndexDisk> disks_;
+  std::vector<IndexLink> links_;
+  std::vector<IndexVmPool> vm_pools_;
+  std::vector<IndexVm> vms_;
+  std::vector<uint32_t> locality_order_; // Host ids, appended in the loader's hosts_by_locality() order
+
+  std::filesystem::path config_dir_;
+  bool compact_names_ = false;
+
+  IndexString str(const std::string& s)
+  {
+    if (strings_.size() + s.size() > UINT32_MAX)
+      throw std::runtime_error("Topology index string table exceeds 4 GB");
+    IndexString ref{static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(s.size())};
+    strings_ += s;
+    return ref;
+  }
+
+  static uint32_t id(size_t index) { return static_cast<uint32_t>(index); }
+
+  static double bandwidth(const std::string& s) { return xbt_parse_get_bandwidth("", 0, s, "bandwidth"); }
+  static double latency(const std::string& s) { return xbt_parse_get_time("", 0, s, "latency"); }
+  static double speed(const std::string& s) { return xbt_parse_get_speed("", 0, s, "speed"); }
+
+  // Same rule as node_resource_name() in the loader
+  std::string node_name(size_t cluster, int index, const std::string& readable, char tag) const
+  {
+    if (not compact_names_)
+      return readable;
+    return "~" + std::to_string(cluster) + "." + std::to_string(index) + tag;
+  }
+
+  uint32_t add_zone(const std::string& name, uint32_t parent, ZoneKind kind, ZoneRouting routing)
+  {
+    zones_.push_back({str(name), parent, kind, routing, id(hosts_.size()), 0, 0});
+    return id(zones_.size() - 1);
+  }
+
+  uint32_t add_host(const std::string& name, uint32_t zone, double host_speed, int cores)
+  {
+    hosts_.push_back({str(name), zone, INDEX_NONE, INDEX_NONE, static_cast<uint32_t>(cores), id(disks_.size()), 0,
+                      host_speed});
+    zones_[zone].host_count++;
+    return id(hosts_.size() - 1);
+  }
+
+  void add_disk(uint32_t host, const std::string& name, const std::string& storage, double read_bw, double write_bw)
+  {
+    disks_.push_back({str(name), str(storage), host, 0, read_bw, write_bw});
+    hosts_[host].disk_count++;
+  }
+
+  void add_link(const std::string& name, uint32_t zone, double link_bw, double link_lat, bool fatpipe = false)
+  {
+    links_.push_back({str(name), zone, fatpipe ? 1U : 0U, link_bw, link_lat});
+  }
+
+  void add_links(uint32_t zone, const json& links_config)
+  {
+    for (const auto& link_cfg : links_config)
+      add_link(link_cfg["name"], zone, bandwidth(link_cfg["bandwidth"]), latency(link_cfg.value("latency", "0s")));
+  }
+
+  void add_storage_system(uint32_t parent, const json& storage_config)
+  {
+    const std::string name = storage_config["name"];
+    uint32_t zone          = add_zone(name, parent, ZoneKind::STORAGE_SYSTEM, ZoneRouting::FULL);
+    uint32_t server        = add_host(name + "_server", zone, speed(storage_config["server_speed"]), 1);
+    locality_order_.push_back(server);
+
+    // As in the loader, storage systems of another type get no disk
+    const std::string type = storage_config["type"];
+    if (type != "JBOD" && type != "OneDisk")
+      return;
+    const double read_bw  = bandwidth(storage_config["read_bandwidth"]);
+    const double write_bw = bandwidth(storage_config["write_bandwidth"]);
+    const int disk_count  = type == "JBOD" ? storage_config["disk_count"].get<int>() : 1;
+    for (int i = 0; i < disk_count; i++) {
+      const std::string disk_name = disk_count == 1 ? name + "_disk" : name + "_disk" + std::to_string(i);
+      add_disk(server, disk_name, name + "_storage", read_bw, write_bw);
+    }
+    if (storage_config.contains("cache")) {
+      const double cache_bw = bandwidth(storage_config["cache"]["bandwidth"]);
+      add_disk(server, name + "_storage_cache", "", cache_bw, cache_bw);
+    }
+  }
+
+  // Private link or backbone of a rail: the cluster's, with the "rail_links" entry of the rail merged in
+  static json rail_setting(const json& cluster_config, int rail, const char* key, json setting)
+  {
+    if (cluster_config.contains("rail_links") && static_cast<size_t>(rail) < cluster_config["rail_links"].size())
+      setting.merge_patch(cluster_config["rail_links"][rail].value(key, json::object()));
+    return setting;
+  }
+
+  void add_cluster(uint32_t parent, const json& cluster_config)
+  {
+    const std::string name   = cluster_config["name"];
+    const std::string prefix = cluster_config["prefix"];
+    const std::string suffix = cluster_config["suffix"];
+    const int count          = cluster_config["count"];
+    const auto& node_cfg     = cluster_config["node"];
+    const auto& link_cfg     = node_cfg["private_link"];
+    const auto& backbone_cfg = cluster_config["backbone"];
+
+    // As in the loader, multi-rail clusters are Full zones with a backbone per rail, named after the rail
+    const int rails           = cluster_config.value("rails", 1);
+    const json rail_link      = rail_setting(cluster_config, 0, "private_link", link_cfg);
+    const json rail_backbone  = rail_setting(cluster_config, 0, "backbone", backbone_cfg);
+    const ZoneRouting routing = rails > 1 ? ZoneRouting::FULL : ZoneRouting::STAR;
+
+    const size_t ordinal = clusters_.size();
+    uint32_t zone        = add_zone(name, parent, ZoneKind::CLUSTER, routing);
+    IndexCluster cluster{str(name),
+                         str(prefix),
+                         str(suffix),
+                         zone,
+                         id(hosts_.size()),
+                         static_cast<uint32_t>(count),
+                         node_cfg["cores"].get<uint32_t>(),
+                         static_cast<uint32_t>(rails),
+                         0,
+                         speed(node_cfg["speed"]),
+                         bandwidth(rail_link["bandwidth"]),
+                         latency(rail_link.value("latency", "0s")),
+                         bandwidth(rail_backbone["bandwidth"]),
+                         latency(rail_backbone.value("latency", "0s"))};
+    clusters_.push_back(cluster);
+    if (rails == 1) {
+      add_link(name + "_backbone", zone, cluster.backbone_bandwidth, cluster.backbone_latency);
+    } else {
+      for (int r = 0; r < rails; r++) {
+        const json rail_cfg = rail_setting(cluster_config, r, "backbone", backbone_cfg);
+        add_link(name + "_rail" + std::to_string(r) + "_backbone", zone, bandwidth(rail_cfg["bandwidth"]),
+                 latency(rail_cfg.value("latency", "0s")));
+      }
+    }
+
+    const bool has_storage = node_cfg.contains("storage");
+    std::string storage_base_name;
+    double read_bw  = 0;
+    double write_bw = 0;
+    double cache_bw = 0; // Page cache memory, 0 without a cache
+    if (has_storage) {
+      storage_base_name = node_cfg["storage"]["name"];
+      read_bw           = bandwidth(node_cfg["storage"]["read_bandwidth"]);
+      write_bw          = bandwidth(node_cfg["storage"]["write_bandwidth"]);
+      if (node_cfg["storage"].contains("cache"))
+        cache_bw = bandwidth(node_cfg["storage"]["cache"]["bandwidth"]);
+    }
+
+    hosts_.reserve(hosts_.size() + count);
+    for (int i = 0; i < count; i++) {
+      const std::string hostname = prefix + std::to_string(i) + suffix;
+      uint32_t host              = add_host(hostname, zone, cluster.speed, static_cast<int>(cluster.cores));
+      hosts_[host].cluster       = id(ordinal);
+      hosts_[host].node_index    = static_cast<uint32_t>(i);
+      if (has_storage) {
+        const std::string readable = hostname + "_" + storage_base_name;
+        add_disk(host, node_name(ordinal, i, readable + "_disk", 'k'), node_name(ordinal, i, readable, 's'), read_bw,
+                 write_bw);
+        if (cache_bw > 0)
+          add_disk(host, node_name(ordinal, i, readable + "_cache", 'c'), "", cache_bw, cache_bw);
+      }
+    }
+
+    for (int i : rack_node_order(resolve_cluster_properties(cluster_config), count))
+      locality_order_.push_back(cluster.first_host + static_cast<uint32_t>(i));
+
+    // VMs in the order build_vm_pool() creates them
+    const uint32_t first_node = cluster.first_host;
+    for (const auto& pool : parse_vm_pools(cluster_config)) {
+      const auto pool_id = id(vm_pools_.size());
+      vm_pools_.push_back({str(pool.name), id(ordinal), id(vms_.size()), static_cast<uint32_t>(pool.per_host),
+                           static_cast<uint32_t>(pool.cores), static_cast<uint64_t>(pool.ramsize)});
+      std::string vm_name;
+      for (int i = 0; i < count; i++) {
+        const std::string hostname = prefix + std::to_string(i) + suffix;
+        const std::string node     = std::to_string(i);
+        for (int v = 0; v < pool.per_host; v++) {
+          pool.vm_name(vm_name, hostname, node, std::to_string(v));
+          vms_.push_back({str(vm_name), first_node + static_cast<uint32_t>(i), pool_id, static_cast<uint32_t>(v), 0});
+        }
+      }
+    }
+  }
+
+  void add_graph(uint32_t parent, const json& graph_config)
+  {
+    const std::string name    = graph_config["name"];
+    const std::string routing = graph_config.value("routing", "Dijkstra");
+    uint32_t zone =
+        add_zone(name, parent, ZoneKind::GRAPH, routing == "Floyd" ? ZoneRouting::FLOYD : ZoneRouting::DIJKSTRA);
+
+    const std::string nodes_path = (config_dir_ / graph_config["nodes"].get<std::string>()).string();
+    std::ifstream nodes(nodes_path);
+    if (not nodes)
+      throw std::runtime_error("Cannot open graph file: " + nodes_path);
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(nodes, line)) {
+      line_number++;
+      std::istringstream tokens(line.substr(0, line.find('#')));
+      std::string kind;
+      std::string vertex;
+      std::string value;
+      if (not(tokens >> kind >> vertex))
+        continue;
+      if (kind == "host" && tokens >> value) {
+        // Same core count check as graph_zone.cpp: optional, and a positive integer when present
+        int cores = 1;
+        std::string cores_token;
+        if (tokens >> cores_token) {
+          const char* end      = cores_token.data() + cores_token.size();
+          const auto [ptr, ec] = std::from_chars(cores_token.data(), end, cores);
+          if (ec != std::errc() || ptr != end || cores < 1)
+            throw std::runtime_error(nodes_path + ":" + std::to_string(line_number) + ": invalid core count '" +
+                                     cores_token + "'");
+        }
+        locality_order_.push_back(add_host(vertex, zone, speed(value), cores));
+      } else if (kind == "link" && tokens >> value) {
+        std::string lat;
+        std::string sharing;
+        tokens >> lat >> sharing;
+        add_link(vertex, zone, bandwidth(value), latency(lat.empty() ? "0s" : lat), sharing == "FATPIPE");
+      }
+    }
+  }
+
+  void add_zone_config(uint32_t parent, const json& zone_config)
+  {
+    const std::string routing = zone_config.value("routing", "Full");
+    uint32_t zone             = add_zone(zone_config["name"], parent, ZoneKind::ZONE,
+                                         routing == "Floyd"      ? ZoneRouting::FLOYD
+                                         : routing == "Dijkstra" ? ZoneRouting::DIJKSTRA
+                                                                 : ZoneRouting::FULL);
+    if (zone_config.contains("storage_systems"))
+      for (const auto& storage_cfg : zone_config["storage_systems"])
+        add_storage_system(zone, storage_cfg);
+    if (zone_config.contains("clusters"))
+      for (const auto& cluster_cfg : zone_config["clusters"])
+        add_cluster(zone, cluster_cfg);
+    if (zone_config.contains("graphs"))
+      for (const auto& graph_cfg : zone_config["graphs"])
+        add_graph(zone, graph_cfg);
+    if (zone_config.contains("zones"))
+      for (const auto& child_cfg : zone_config["zones"])
+        add_zone_config(zone, child_cfg);
+    if (zone_config.contains("links"))
+      add_links(zone, zone_config["links"]);
+  }
+
+  template <typename T> static void write_section(std::ofstream& out, IndexHeader& header, IndexSection id,
+                                                  const T* data, size_t count)
+  {
+    auto offset = static_cast<uint64_t>(out.tellp());
+    if (offset % 8 != 0) {
+      const char padding[8] = {};
+      out.write(padding, static_cast<std::streamsize>(8 - offset % 8));
+      offset += 8 - offset % 8;
+    }
+    header.sections[id] = {offset, count};
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+  }
+
+public:
+  IndexBuilder(std::filesystem::path config_dir, bool compact_names)
+      : config_dir_(std::move(config_dir)), compact_names_(compact_names)
+  {
+  }
+
+  // Same order as load_platform(): facilities (and their zones), then top-level storage systems and links
+  void build(const json& config)
+  {
+    uint32_t world = add_zone("_world_", INDEX_NONE, ZoneKind::WORLD, ZoneRouting::FULL);
+    for (const auto& dc_config : config["facilities"])
+      add_zone_config(world, dc_config);
+    if (config.contains("storage_systems"))
+      for (const auto& storage_cfg : config["storage_systems"])
+        add_storage_system(world, storage_cfg);
+    if (config.contains("links"))
+      add_links(world, config["links"]);
+  }
+
+  IndexStats write(const std::string& path) const
+  {
+    if (hosts_.size() >= INDEX_NONE || disks_.size() >= INDEX_NONE || vms_.size() >= INDEX_NONE)
+      throw std::runtime_error("Too many hosts, disks or VMs for a topology index");
+
+    std::vector<uint32_t> host_order(hosts_.size());
+    std::iota(host_order.begin(), host_order.end(), 0);
+    auto name = [this](IndexString s) { return std::string_view(strings_).substr(s.offset, s.length); };
+    std::sort(host_order.begin(), host_order.end(),
+              [this, &name](uint32_t a, uint32_t b) { return name(hosts_[a].name) < name(hosts_[b].name); });
+    std::vector<uint32_t> vm_order(vms_.size());
+    std::iota(vm_order.begin(), vm_order.end(), 0);
+    std::sort(vm_order.begin(), vm_order.end(),
+              [this, &name](uint32_t a, uint32_t b) { return name(vms_[a].name) < name(vms_[b].name); });
+
+    // Written to a temporary file first, so that readers never map a partial index
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (not out)
+      throw std::runtime_error("Cannot write topology index: " + path);
+
+    IndexHeader header{};
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version    = INDEX_VERSION;
+    header.byte_order = INDEX_BYTE_ORDER;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_section(out, header, SECTION_STRINGS, strings_.data(), strings_.size());
+    write_section(out, header, SECTION_ZONES, zones_.data(), zones_.size());
+    write_section(out, header, SECTION_CLUSTERS, clusters_.data(), clusters_.size());
+    write_section(out, header, SECTION_HOSTS, hosts_.data(), hosts_.size());
+    write_section(out, header, SECTION_DISKS, disks_.data(), disks_.size());
+    write_section(out, header, SECTION_LINKS, links_.data(), links_.size());
+    write_section(out, header, SECTION_HOST_ORDER, host_order.data(), host_order.size());
+    write_section(out, header, SECTION_VM_POOLS, vm_pools_.data(), vm_pools_.size());
+    write_section(out, header, SECTION_VMS, vms_.data(), vms_.size());
+    write_section(out, header, SECTION_VM_ORDER, vm_order.data(), vm_order.size());
+    write_section(out, header, SECTION_LOCALITY_ORDER, locality_order_.data(), locality_order_.size());
+    header.file_size = static_cast<uint64_t>(out.tellp());
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (not out)
+      throw std::runtime_error("Cannot write topology index: " + path);
+    std::filesystem::rename(tmp_path, path);
+
+    return {zones_.size(), clusters_.size(), hosts_.size(), disks_.size(), links_.size(), vms_.size(),
+            header.file_size};
+  }
+};
+
+} // namespace
+
+IndexStats write_topology_index(const json& config, const std::filesystem::path& config_dir, const std::string& path)
+{
+  const std::string naming = config.value("naming", "readable");
+  if (naming != "readable" && naming != "compact")
+    throw std::runtime_error("Unknown naming '" + naming + "' (expected readable or compact)");
+
+  IndexBuilder builder(config_dir, naming == "compact");
+  builder.build(config);
+  return builder.write(path);
+}
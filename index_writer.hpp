@@ -0,0 +1,41 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file index_writer.hpp
+ * @brief Writer of the topology index described in topology_index.hpp.
+ *
+ * The index is built from the JSON configuration, following the order in
+ * which load_platform() creates zones, hosts and disks and the same naming
+ * rules, so that it matches the loaded platform without walking it. Graph
+ * zones are read from their node files, VM pools are expanded from their
+ * naming patterns.
+ */
+
+#ifndef INDEX_WRITER_HPP
+#define INDEX_WRITER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+struct IndexStats {
+  size_t zones    = 0;
+  size_t clusters = 0;
+  size_t hosts    = 0;
+  size_t disks    = 0;
+  size_t links    = 0;
+  size_t vms      = 0;
+  size_t bytes    = 0;
+};
+
+/** Write the topology index of the platform described by @p config to @p path.
+ *  Relative file names of the configuration are resolved from @p config_dir. */
+IndexStats write_topology_index(const nlohmann::json& config, const std::filesystem::path& config_dir,
+                                const std::string& path);
+
+#endif
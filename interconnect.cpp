@@ -0,0 +1,216 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include "interconnect.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+enum class PathMetric { HOPS, LATENCY, WIDEST };
+
+struct Edge {
+  size_t a;
+  size_t b;
+  size_t link; // Index in Graph::link_names
+};
+
+struct Graph {
+  size_t zone_count = 0; // Vertices [0, zone_count) are zones, the others routers
+  std::vector<std::string> vertex_names;
+  std::vector<std::string> link_names;
+  std::vector<LinkMetrics> link_metrics;
+  std::vector<Edge> edges;
+  std::vector<std::vector<size_t>> adjacency; // Vertex -> incident edges
+};
+
+// Path cost compared lexicographically; extending a path never makes it better
+struct Label {
+  double primary   = std::numeric_limits<double>::infinity();
+  double secondary = std::numeric_limits<double>::infinity();
+
+  bool operator<(const Label& other) const
+  {
+    return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+  }
+};
+
+Label extend(const Label& label, const LinkMetrics& link, PathMetric metric)
+{
+  switch (metric) {
+    case PathMetric::HOPS:
+      return {label.primary + 1, label.secondary + link.latency};
+    case PathMetric::LATENCY:
+      return {label.primary + link.latency, label.secondary + 1};
+    case PathMetric::WIDEST:
+    default:
+      // Bottleneck bandwidth, negated so that smaller is better
+      return {std::max(label.primary, -link.bandwidth), label.secondary + 1};
+  }
+}
+
+Graph build_graph(const json& facility_config, const LinkMetricsFn& link_metrics)
+{
+  Graph graph;
+  std::unordered_map<std::string, size_t> vertex_ids;
+  for (const char* key : {"storage_systems", "clusters", "graphs", "zones"})
+    if (facility_config.contains(key))
+      for (const auto& zone_cfg : facility_config[key]) {
+        vertex_ids.emplace(zone_cfg["name"].get<std::string>(), graph.vertex_names.size());
+        graph.vertex_names.push_back(zone_cfg["name"]);
+      }
+  graph.zone_count = graph.vertex_names.size();
+
+  auto vertex = [&](const std::string& name) {
+    auto [it, inserted] = vertex_ids.emplace(name, graph.vertex_names.size());
+    if (inserted)
+      graph.vertex_names.push_back(name);
+    return it->second;
+  };
+  std::unordered_map<std::string, size_t> link_ids;
+  for (const auto& edge_cfg : facility_config["interconnect"]["edges"]) {
+    const std::string link_name = edge_cfg["link"];
+    auto [it, inserted]         = link_ids.emplace(link_name, graph.link_names.size());
+    if (inserted) {
+      graph.link_names.push_back(link_name);
+      graph.link_metrics.push_back(link_metrics(link_name));
+    }
+    graph.edges.push_back({vertex(edge_cfg["src"]), vertex(edge_cfg["dst"]), it->second});
+  }
+
+  graph.adjacency.resize(graph.vertex_names.size());
+  for (size_t e = 0; e < graph.edges.size(); e++) {
+    graph.adjacency[graph.edges[e].a].push_back(e);
+    graph.adjacency[graph.edges[e].b].push_back(e);
+  }
+  return graph;
+}
+
+// Best paths from zone `source` to the zones after it, as lists of link indices (empty when unreachable)
+std::vector<std::vector<size_t>> paths_from(const Graph& graph, size_t source, PathMetric metric)
+{
+  const size_t n = graph.vertex_names.size();
+  std::vector<Label> best(n);
+  std::vector<size_t> via_edge(n, SIZE_MAX);
+  std::vector<bool> done(n, false);
+  using Entry = std::pair<Label, size_t>;
+  auto worse  = [](const Entry& x, const Entry& y) { return y.first < x.first; };
+  std::priority_queue<Entry, std::vector<Entry>, decltype(worse)> queue(worse);
+
+  best[source] = {metric == PathMetric::WIDEST ? -std::numeric_limits<double>::infinity() : 0.0, 0.0};
+  queue.push({best[source], source});
+  while (not queue.empty()) {
+    auto [label, v] = queue.top();
+    queue.pop();
+    if (done[v])
+      continue;
+    done[v] = true;
+    // Zones terminate paths: traffic between two zones never crosses a third one
+    if (v != source && v < graph.zone_count)
+      continue;
+    for (size_t e : graph.adjacency[v]) {
+      const Edge& edge = graph.edges[e];
+      size_t w         = (edge.a == v) ? edge.b : edge.a;
+      Label candidate  = extend(label, graph.link_metrics[edge.link], metric);
+      if (not done[w] && candidate < best[w]) {
+        best[w]     = candidate;
+        via_edge[w] = e;
+        queue.push({candidate, w});
+      }
+    }
+  }
+
+  std::vector<std::vector<size_t>> paths(graph.zone_count);
+  for (size_t dst = source + 1; dst < graph.zone_count; dst++) {
+    for (size_t v = dst; via_edge[v] != SIZE_MAX && v != source;) {
+      const Edge& edge = graph.edges[via_edge[v]];
+      paths[dst].push_back(edge.link);
+      v = (edge.a == v) ? edge.b : edge.a;
+    }
+    std::reverse(paths[dst].begin(), paths[dst].end());
+  }
+  return paths;
+}
+
+} // namespace
+
+std::vector<InterconnectRoute> compute_interconnect_routes(const json& facility_config,
+                                                           const LinkMetricsFn& link_metrics, unsigned threads)
+{
+  if (not facility_config.contains("interconnect"))
+    return {};
+  const auto& interconnect_cfg = facility_config["interconnect"];
+
+  const std::string metric_name = interconnect_cfg.value("metric", "hops");
+  PathMetric metric;
+  if (metric_name == "hops")
+    metric = PathMetric::HOPS;
+  else if (metric_name == "latency")
+    metric = PathMetric::LATENCY;
+  else if (metric_name == "widest")
+    metric = PathMetric::WIDEST;
+  else
+    throw std::runtime_error("Unknown interconnect metric '" + metric_name + "' in facility " +
+                             facility_config["name"].get<std::string>() + " (expected hops, latency or widest)");
+
+  const Graph graph = build_graph(facility_config, link_metrics);
+
+  // Pairs with an explicit route keep it
+  std::set<std::pair<std::string, std::string>> explicit_pairs;
+  if (facility_config.contains("routes"))
+    for (const auto& route_cfg : facility_config["routes"]) {
+      explicit_pairs.emplace(route_cfg["src"], route_cfg["dst"]);
+      explicit_pairs.emplace(route_cfg["dst"], route_cfg["src"]);
+    }
+
+  // One shortest-path tree per source zone, handed out dynamically to the workers
+  std::vector<std::vector<std::vector<size_t>>> paths(graph.zone_count);
+  if (threads == 0)
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  threads = std::max(1U, std::min<unsigned>(threads, static_cast<unsigned>(graph.zone_count)));
+  std::atomic<size_t> next_source{0};
+  auto worker = [&]() {
+    for (size_t src = next_source++; src < graph.zone_count; src = next_source++)
+      paths[src] = paths_from(graph, src, metric);
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; t++)
+    pool.emplace_back(worker);
+  worker();
+  for (auto& thread : pool)
+    thread.join();
+
+  std::vector<InterconnectRoute> routes;
+  for (size_t src = 0; src < graph.zone_count; src++) {
+    for (size_t dst = src + 1; dst < graph.zone_count; dst++) {
+      const auto& path = paths[src][dst];
+      if (path.empty() || explicit_pairs.count({graph.vertex_names[src], graph.vertex_names[dst]}) != 0)
+        continue;
+      InterconnectRoute route{graph.vertex_names[src], graph.vertex_names[dst], {}};
+      for (size_t link : path)
+        route.links.push_back(graph.link_names[link]);
+      routes.push_back(std::move(route));
+    }
+  }
+  return routes;
+}
+
+json to_routes_config(const std::vector<InterconnectRoute>& routes)
+{
+  json routes_config = json::array();
+  for (const auto& route : routes)
+    routes_config.push_back({{"src", route.src}, {"dst", route.dst}, {"links", route.links}});
+  return routes_config;
+}
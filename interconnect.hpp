@@ -0,0 +1,61 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file interconnect.hpp
+ * @brief Routes of a facility computed from a graph of its inter-zone links.
+ *
+ * Instead of listing a route for every pair of zones, a facility can describe
+ * its network as a graph:
+ *
+ *   "interconnect": {
+ *     "metric": "latency",
+ *     "edges": [{"src": "compute", "dst": "core", "link": "compute_uplink"}, ...]
+ *   }
+ *
+ * Edge endpoints are the facility's zones (storage systems, clusters, graphs, nested zones)
+ * or any other name, which then stands for a router joining the links that
+ * reach it. Links are the facility's "links". Zones only terminate paths: a
+ * route never crosses a third zone. For every pair of zones not joined by an
+ * explicit route, the path minimizing the metric is turned into a symmetric
+ * route: "hops" (default), "latency" (sum of link latencies), or "widest"
+ * (largest bottleneck bandwidth). Ties favor fewer hops, or lower latency
+ * when the metric is already "hops".
+ * Paths are computed from every source zone in parallel; SimGrid is not used
+ * here, so that the loader, the route checker and the exporters share the code.
+ */
+
+#ifndef INTERCONNECT_HPP
+#define INTERCONNECT_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+struct InterconnectRoute {
+  std::string src;
+  std::string dst;
+  std::vector<std::string> links;
+};
+
+struct LinkMetrics {
+  double bandwidth; // Bytes per second
+  double latency;   // Seconds
+};
+
+/** Bandwidth and latency of a facility link, by name; throws if the link is unknown */
+using LinkMetricsFn = std::function<LinkMetrics(const std::string&)>;
+
+/** Routes between the zones of @p facility_config induced by its "interconnect" graph (none without one).
+ *  @p threads is the number of worker threads (0 means one per hardware thread). */
+std::vector<InterconnectRoute> compute_interconnect_routes(const nlohmann::json& facility_config,
+                                                           const LinkMetricsFn& link_metrics, unsigned threads = 0);
+
+/** The same routes, in the format of a facility's "routes" list */
+nlohmann::json to_routes_config(const std::vector<InterconnectRoute>& routes);
+
+#endif
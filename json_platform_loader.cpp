@@ -3,12 +3,23 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
 #include <dlfcn.h>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -17,14 +28,25 @@
 #include <fsmod/JBODStorage.hpp>
 #include <fsmod/OneDiskStorage.hpp>
 #include <simgrid/s4u.hpp>
+#include <xbt/parse_units.hpp>
+
+#include "cluster_builder.hpp"
+#include "config_expander.hpp"
+#include "graph_zone.hpp"
+#include "host_names.hpp"
+#include "index_writer.hpp"
+#include "interconnect.hpp"
+#include "json_platform_loader.hpp"
+#include "load_monitor.hpp"
+#include "page_cache.hpp"
+#include "property_sets.hpp"
+#include "route_checker.hpp"
+#include "vm_pools.hpp"
 
 namespace sg4  = simgrid::s4u;
 namespace sgfs = simgrid::fsmod;
 using json     = nlohmann::json;
 
-// Forward declaration for dladdr
-extern "C" void load_platform(const sg4::Engine& e);
-
 std::string get_config_path()
 {
   // First, check environment variable
@@ -48,6 +70,143 @@ std::map<std::string, std::shared_ptr<sgfs::Storage>> storage_map;
 std::map<std::string, sg4::NetZone*> zone_map;
 std::map<std::string, const sg4::Link*> link_map;
 
+// Naming of the per-node links, disks and storages of cluster zones (top-level "naming" key).
+// Readable names derive from the hostname (node-12_LinkUP). Compact names are index-based
+// ("~3.12u": cluster 3, node 12, link up), fit in std::string's inline buffer, and are cheaper
+// for SimGrid to store, hash and compare; the optional "name_map" file lists them for humans.
+enum class NodeNaming { READABLE, COMPACT };
+NodeNaming node_naming = NodeNaming::READABLE;
+std::map<std::string, size_t> cluster_ordinals;
+std::ofstream name_map_file;
+
+std::string node_resource_name(size_t cluster_ordinal, int index, const std::string& readable, char tag)
+{
+  if (node_naming == NodeNaming::READABLE)
+    return readable;
+  std::string name = "~" + std::to_string(cluster_ordinal) + "." + std::to_string(index);
+  name += tag;
+  return name;
+}
+
+// Visit facilities and, recursively, the zones nested in them
+void for_each_zone_config(const json& zones_config, const std::function<void(const json&)>& visit)
+{
+  for (const auto& zone_config : zones_config) {
+    visit(zone_config);
+    if (zone_config.contains("zones")) {
+      for_each_zone_config(zone_config["zones"], visit);
+    }
+  }
+}
+
+// Cluster filesystems with "lazy": true. Their per-node partitions are mounted by materialize_partitions(),
+// the first time an actor starts on the node or when the simulator asks for it, so that load time and
+// memory scale with the nodes actually used. When no eager filesystem uses a cluster's node storage,
+// the storages themselves are created on demand as well (the disks, being part of the SimGrid
+// platform, are always created at load time).
+struct LazyClusterFilesystem {
+  std::shared_ptr<sgfs::FileSystem> fs;
+  size_t ordinal;
+  std::string prefix;
+  std::string suffix;
+  std::string storage_base_name;
+  std::string mount_point_pattern;
+  std::string size;
+  std::vector<bool> mounted;
+};
+std::vector<LazyClusterFilesystem> lazy_filesystems;
+std::map<std::string, std::vector<size_t>> lazy_filesystems_by_cluster;
+std::set<std::string> lazy_storage_clusters;
+
+// VMs of the cluster VM pools, by cluster and pool name (see vm_pools.hpp)
+std::map<std::pair<std::string, std::string>, std::vector<sg4::VirtualMachine*>> vm_pools;
+
+// Hosts in locality order (see hosts_by_locality()): appended as zones are created, so that hosts of a zone,
+// and of a rack within a cluster, are consecutive
+std::vector<sg4::Host*> locality_hosts;
+
+// Hosts and VMs by name, for lookup_host() (see host_names.hpp)
+HostNameTable host_names;
+
+// Property sets of the cluster nodes, kept once per cluster whether or not they are also copied into the hosts
+// (top-level "host_properties": "copy" or "shared"), for host_properties()
+NodePropertyTable node_property_sets;
+bool share_host_properties = false;
+
+// Nodes of each cluster by cluster name, node i at index i
+std::map<std::string, std::vector<sg4::Host*>> cluster_nodes;
+
+// Speeds that the points of a parameter sweep give to the nodes of a cluster or the server of a storage system,
+// by zone name; the base speed first. The hosts get them as pstates (see run_parameter_sweep()).
+std::map<std::string, std::vector<double>> sweep_speeds;
+
+// Clusters whose node storages are only used by lazy filesystems
+std::set<std::string> find_lazy_storage_clusters(const json& config)
+{
+  std::set<std::string> lazy;
+  std::set<std::string> eager;
+  if (config.contains("filesystems")) {
+    for (const auto& fs_cfg : config["filesystems"]) {
+      if (fs_cfg.contains("cluster")) {
+        (fs_cfg.value("lazy", false) ? lazy : eager).insert(fs_cfg["cluster"].get<std::string>());
+      }
+    }
+  }
+  for (const auto& name : eager) {
+    lazy.erase(name);
+  }
+  return lazy;
+}
+
+// Cluster settings resolved without SimGrid: node units, storage features and host properties
+struct ClusterPlan {
+  ClusterNodeContext ctx; // Without the SimGrid objects, compact prefix and name map set when building
+  double backbone_bandwidth;
+  double backbone_latency;
+  unsigned features = 0; // NODE_STORAGE and NODE_STORAGE_FS; naming features are added when building
+  ClusterProperties properties;
+  std::vector<int> node_order; // Nodes grouped by rack, for hosts_by_locality()
+  std::vector<VmPoolConfig> vm_pools;
+  bool node_cache = false; // Page cache in front of each node storage
+  PageCacheConfig node_cache_config;
+  RailPolicy rail_policy = RailPolicy::HASH;              // With NODE_RAILS
+  std::vector<std::pair<double, double>> rail_backbones; // Bandwidth and latency, with NODE_RAILS
+};
+
+// Everything load_platform() can do before touching SimGrid, so that begin_load() can do it in the background
+struct PlatformPlan {
+  std::filesystem::path config_dir;
+  json config;
+  NodeNaming naming          = NodeNaming::READABLE;
+  bool share_host_properties = false; // Top-level "host_properties": "shared"
+  std::map<std::string, size_t> totals;
+  std::set<std::string> lazy_storage_clusters;
+  std::map<std::string, ClusterPlan> clusters;       // By cluster name
+  std::map<std::string, json> interconnect_routes; // By zone name, in the format of "routes"
+};
+
+// "cache" block of a storage (see page_cache.hpp)
+PageCacheConfig parse_cache_config(const json& cache_config, const std::string& storage_name)
+{
+  PageCacheConfig cache;
+  cache.size      = static_cast<sg_size_t>(xbt_parse_get_size(storage_name, 0, cache_config["size"], "size"));
+  cache.bandwidth = xbt_parse_get_bandwidth(storage_name, 0, cache_config["bandwidth"], "bandwidth");
+  if (cache_config.contains("block_size")) {
+    cache.block_size =
+        static_cast<sg_size_t>(xbt_parse_get_size(storage_name, 0, cache_config["block_size"], "block_size"));
+  }
+  const std::string policy = cache_config.value("policy", "lru");
+  if (policy == "fifo") {
+    cache.policy = PageCacheConfig::Policy::FIFO;
+  } else if (policy != "lru") {
+    throw std::runtime_error("Unknown cache policy '" + policy + "' for " + storage_name + " (expected lru or fifo)");
+  }
+  if (cache.block_size == 0) {
+    throw std::runtime_error("Cache of " + storage_name + " needs a positive block size");
+  }
+  return cache;
+}
+
 void create_storage_system_zone(sg4::NetZone* parent, const json& storage_config)
 {
   const std::string name = storage_config["name"];
@@ -62,6 +221,11 @@ void create_storage_system_zone(sg4::NetZone* parent, const json& storage_config
   // Create server host
   const std::string server_speed = storage_config["server_speed"];
   auto* server = zone->add_host(server_name, server_speed);
+  if (auto speeds = sweep_speeds.find(name); speeds != sweep_speeds.end()) {
+    server->set_pstate_speed(speeds->second);
+  }
+  locality_hosts.push_back(server);
+  host_names.add_host(server);
 
   // Create storage
   const std::string storage_type = storage_config["type"];
@@ -81,87 +245,226 @@ void create_storage_system_zone(sg4::NetZone* parent, const json& storage_config
     storage_map[storage_name] = sgfs::OneDiskStorage::create(storage_name, disk);
   }
 
+  // Page cache in the server's memory, in front of the storage's disks
+  if (storage_config.contains("cache") && storage_map.count(storage_name) != 0) {
+    const PageCacheConfig cache   = parse_cache_config(storage_config["cache"], storage_name);
+    std::vector<sg4::Disk*> disks = server->get_disks();
+    auto* memory                  = server->add_disk(storage_name + "_cache", cache.bandwidth, cache.bandwidth);
+    add_page_cache(storage_name, cache, memory, std::move(disks));
+  }
+
   // Always add gateway router for consistent routing behavior
   const std::string router_name = name + "_router";
   zone->set_gateway(zone->add_router(router_name));
 
   zone->seal();
+  load_monitor.advance();
 }
 
-void create_cluster_zone(sg4::NetZone* parent, const json& cluster_config)
+ClusterPlan plan_cluster(const json& cluster_config, const std::set<std::string>& lazy_storage)
 {
-  const std::string name   = cluster_config["name"];
-  const std::string prefix = cluster_config["prefix"];
-  const std::string suffix = cluster_config["suffix"];
-  int count                = cluster_config["count"];
+  const std::string name = cluster_config["name"];
+  ClusterPlan plan;
 
-  auto* cluster  = parent->add_netzone_star(name);
-  zone_map[name] = cluster;
+  const auto& backbone_cfg = cluster_config["backbone"];
+  plan.backbone_bandwidth  = xbt_parse_get_bandwidth(name, 0, backbone_cfg["bandwidth"], "bandwidth");
+  plan.backbone_latency    = xbt_parse_get_time(name, 0, backbone_cfg.value("latency", "0s"), "latency");
 
-  // Create backbone
-  const auto& backbone_cfg       = cluster_config["backbone"];
-  const std::string backbone_bw  = backbone_cfg["bandwidth"];
-  const std::string backbone_lat = backbone_cfg.value("latency", "0s");
-  const std::string backbone_name = name + "_backbone";
-  const auto* backbone = cluster->add_link(backbone_name, backbone_bw)->set_latency(backbone_lat);
+  // Node configuration, with units parsed once for all nodes
+  const auto& node_cfg         = cluster_config["node"];
+  const auto& private_link_cfg = node_cfg["private_link"];
+  const auto& loopback_cfg     = node_cfg["loopback"];
 
-  // Node configuration
-  const auto& node_cfg = cluster_config["node"];
+  ClusterNodeContext& ctx = plan.ctx;
+  ctx.prefix             = cluster_config["prefix"];
+  ctx.suffix             = cluster_config["suffix"];
+  ctx.speed              = xbt_parse_get_speed(name, 0, node_cfg["speed"], "speed");
+  ctx.cores              = node_cfg["cores"];
+  ctx.link_bandwidth     = xbt_parse_get_bandwidth(name, 0, private_link_cfg["bandwidth"], "bandwidth");
+  ctx.link_latency       = xbt_parse_get_time(name, 0, private_link_cfg.value("latency", "0s"), "latency");
+  ctx.loopback_bandwidth = xbt_parse_get_bandwidth(name, 0, loopback_cfg["bandwidth"], "bandwidth");
+  ctx.loopback_latency   = xbt_parse_get_time(name, 0, loopback_cfg.value("latency", "0s"), "latency");
 
-  const std::string host_speed = node_cfg["speed"];
-  int host_cores               = node_cfg["cores"];
+  // Node storage is always OneDisk
+  if (node_cfg.contains("storage")) {
+    const auto& storage_cfg     = node_cfg["storage"];
+    ctx.storage_suffix          = "_" + storage_cfg["name"].get<std::string>();
+    ctx.storage_read_bandwidth  = xbt_parse_get_bandwidth(name, 0, storage_cfg["read_bandwidth"], "bandwidth");
+    ctx.storage_write_bandwidth = xbt_parse_get_bandwidth(name, 0, storage_cfg["write_bandwidth"], "bandwidth");
+    plan.features |= NODE_STORAGE;
+    if (lazy_storage.count(name) == 0) {
+      plan.features |= NODE_STORAGE_FS;
+    }
+    if (storage_cfg.contains("cache")) {
+      plan.node_cache        = true;
+      plan.node_cache_config = parse_cache_config(storage_cfg["cache"], name + ctx.storage_suffix);
+    }
+  }
 
-  const auto& private_link_cfg   = node_cfg["private_link"];
-  const std::string link_bw      = private_link_cfg["bandwidth"];
-  const std::string link_lat     = private_link_cfg.value("latency", "0s");
+  // Rails, each one with the cluster's private link and backbone unless "rail_links" overrides them
+  const int rails = cluster_config.value("rails", 1);
+  if (rails < 1) {
+    throw std::runtime_error("Cluster " + name + " needs at least one rail");
+  }
+  if (rails > 1) {
+    if (cluster_config["count"].get<int>() > MAX_RAIL_NODES) {
+      throw std::runtime_error("Cluster " + name + " has more than " + std::to_string(MAX_RAIL_NODES) +
+                               " nodes, too many for multiple rails (one route per pair of nodes)");
+    }
+    const json rail_links = cluster_config.value("rail_links", json::array());
+    if (rail_links.size() > static_cast<size_t>(rails)) {
+      throw std::runtime_error("Cluster " + name + " has more rail_links than rails");
+    }
+    for (int r = 0; r < rails; r++) {
+      json link_cfg = private_link_cfg;
+      json rail_cfg = backbone_cfg;
+      if (static_cast<size_t>(r) < rail_links.size()) {
+        link_cfg.merge_patch(rail_links[r].value("private_link", json::object()));
+        rail_cfg.merge_patch(rail_links[r].value("backbone", json::object()));
+      }
+      ctx.rails.push_back({xbt_parse_get_bandwidth(name, 0, link_cfg["bandwidth"], "bandwidth"),
+                           xbt_parse_get_time(name, 0, link_cfg.value("latency", "0s"), "latency")});
+      plan.rail_backbones.emplace_back(xbt_parse_get_bandwidth(name, 0, rail_cfg["bandwidth"], "bandwidth"),
+                                       xbt_parse_get_time(name, 0, rail_cfg.value("latency", "0s"), "latency"));
+    }
+    const std::string policy = cluster_config.value("rail_policy", "hash");
+    if (policy == "parity") {
+      plan.rail_policy = RailPolicy::PARITY;
+    } else if (policy != "hash") {
+      throw std::runtime_error("Unknown rail policy '" + policy + "' for cluster " + name +
+                               " (expected hash or parity)");
+    }
+    plan.features |= NODE_RAILS;
+  }
 
-  const auto& loopback_cfg       = node_cfg["loopback"];
-  const std::string loopback_bw  = loopback_cfg["bandwidth"];
-  const std::string loopback_lat = loopback_cfg.value("latency", "0s");
+  // Host properties, resolved once per distinct set (see property_sets.hpp)
+  plan.properties = resolve_cluster_properties(cluster_config);
+  plan.node_order = rack_node_order(plan.properties, cluster_config["count"]);
+  plan.vm_pools   = parse_vm_pools(cluster_config);
+  return plan;
+}
 
-  // Check for node storage (always OneDisk for node-local storage)
-  bool has_storage = node_cfg.contains("storage");
-  std::string storage_base_name;
-  std::string storage_read_bw;
-  std::string storage_write_bw;
+// Cache of a node storage of a cluster, from the node's disks: its storage disk, then the cache memory. Storage
+// names are "<hostname><storage suffix>", or "~<cluster>.<node>s" with compact naming; @p first_position is the
+// position of node 0 in host_names.
+PageCacheFactory node_cache_factory(const std::vector<sg4::Host*>& hosts, size_t first_position, size_t ordinal,
+                                    const std::string& storage_suffix, const PageCacheConfig& config)
+{
+  const std::string compact_prefix = "~" + std::to_string(ordinal) + ".";
+  return [&hosts, first_position, compact_prefix, storage_suffix, config](const std::string& storage_name) {
+    const std::string_view name = storage_name;
+    size_t index                = hosts.size();
+    if (node_naming == NodeNaming::COMPACT) {
+      // Node index between the cluster prefix and the tag, without leading zeros
+      if (name.size() > compact_prefix.size() + 1 && name.substr(0, compact_prefix.size()) == compact_prefix &&
+          name.back() == 's') {
+        const std::string_view digits = name.substr(compact_prefix.size(), name.size() - compact_prefix.size() - 1);
+        const auto [ptr, ec]          = std::from_chars(digits.data(), digits.data() + digits.size(), index);
+        if (ec != std::errc() || ptr != digits.data() + digits.size() || (digits.size() > 1 && digits[0] == '0')) {
+          index = hosts.size();
+        }
+      }
+    } else if (name.size() > storage_suffix.size() &&
+               name.substr(name.size() - storage_suffix.size()) == storage_suffix) {
+      // Wraps around for hosts before the cluster
+      index = host_names.position(name.substr(0, name.size() - storage_suffix.size())) - first_position;
+    }
+    if (index >= hosts.size()) {
+      return std::unique_ptr<PageCache>();
+    }
+    const auto& disks = hosts[index]->get_disks();
+    return std::make_unique<PageCache>(storage_name, config, disks.at(1), std::vector<sg4::Disk*>{disks.at(0)});
+  };
+}
 
-  if (has_storage) {
-    const auto& storage_cfg = node_cfg["storage"];
-    storage_base_name       = storage_cfg["name"];
-    storage_read_bw         = storage_cfg["read_bandwidth"];
-    storage_write_bw        = storage_cfg["write_bandwidth"];
-  }
+void create_cluster_zone(sg4::NetZone* parent, const json& cluster_config, const ClusterPlan& plan)
+{
+  const std::string name   = cluster_config["name"];
+  int count                = cluster_config["count"];
 
-  // Create nodes
-  for (int i = 0; i < count; i++) {
-    std::string hostname = prefix + std::to_string(i) + suffix;
-    auto* host           = cluster->add_host(hostname, host_speed)->set_core_count(host_cores);
+  // Multi-rail clusters are routed pair by pair (see cluster_builder.hpp)
+  const bool multi_rail = (plan.features & NODE_RAILS) != 0;
+  auto* cluster         = multi_rail ? parent->add_netzone_full(name) : parent->add_netzone_star(name);
+  zone_map[name]        = cluster;
+  const size_t ordinal = cluster_ordinals.size();
+  cluster_ordinals[name] = ordinal;
 
-    // Create node storage if configured (always OneDisk for node-local storage)
-    if (has_storage) {
-      std::string storage_name = hostname + "_" + storage_base_name;
-      std::string disk_name    = storage_name + "_disk";
-      auto* disk               = host->add_disk(disk_name, storage_read_bw, storage_write_bw);
-      storage_map[storage_name] = sgfs::OneDiskStorage::create(storage_name, disk);
+  ClusterNodeContext ctx = plan.ctx;
+  ctx.zone               = cluster;
+  ctx.compact_prefix     = "~" + std::to_string(ordinal) + ".";
+  ctx.storages           = &storage_map;
+  ctx.name_map           = &name_map_file;
+
+  // Create backbone, or one per rail
+  auto& hosts = cluster_nodes[name];
+  hosts.resize(count);
+  std::vector<const sg4::Link*> rail_links;
+  ctx.hosts = &hosts;
+  if (multi_rail) {
+    for (size_t r = 0; r < ctx.rails.size(); r++) {
+      const auto& [bandwidth, latency] = plan.rail_backbones[r];
+      const std::string backbone_name  = name + "_rail" + std::to_string(r) + "_backbone";
+      ctx.rails[r].backbone            = cluster->add_link(backbone_name, bandwidth)->set_latency(latency);
     }
+    rail_links.resize(2 * static_cast<size_t>(count) * ctx.rails.size());
+    ctx.rail_links = &rail_links;
+  } else {
+    ctx.backbone = cluster->add_link(name + "_backbone", plan.backbone_bandwidth)->set_latency(plan.backbone_latency);
+  }
 
-    // Create links (up/down as separate links for compatibility)
-    auto* link_up   = cluster->add_link(hostname + "_LinkUP", link_bw)->set_latency(link_lat);
-    auto* link_down = cluster->add_link(hostname + "_LinkDOWN", link_bw)->set_latency(link_lat);
-    auto* loopback  = cluster->add_link(hostname + "_loopback", loopback_bw)
-                          ->set_latency(loopback_lat)
-                          ->set_sharing_policy(sg4::Link::SharingPolicy::FATPIPE);
+  // The node features select the node kernel (see cluster_builder.hpp)
+  unsigned features = plan.features;
+  if (node_naming == NodeNaming::COMPACT) {
+    features |= NODE_COMPACT;
+    if (name_map_file.is_open()) {
+      features |= NODE_NAME_MAP;
+    }
+  }
+  build_nodes(ctx, count, features, share_host_properties ? ClusterProperties() : plan.properties);
+  for (int i : plan.node_order) {
+    locality_hosts.push_back(hosts[i]);
+  }
+  const size_t first_position = host_names.add_cluster(ctx.prefix, ctx.suffix, hosts);
+  node_property_sets.add_cluster(first_position, plan.properties);
+  if (auto speeds = sweep_speeds.find(name); speeds != sweep_speeds.end()) {
+    for (auto* host : hosts) {
+      host->set_pstate_speed(speeds->second);
+    }
+  }
 
-    // Add routes
-    cluster->add_route(host, nullptr, {sg4::LinkInRoute(link_up), sg4::LinkInRoute(backbone)}, false);
-    cluster->add_route(nullptr, host, {sg4::LinkInRoute(backbone), sg4::LinkInRoute(link_down)}, false);
-    cluster->add_route(host, host, {loopback});
+  // Page caches of the node storages, in the nodes' memory. The memory disks are added before the zone is
+  // sealed; the caches themselves are made on first use (see node_cache_factory())
+  if (plan.node_cache) {
+    const double bandwidth = plan.node_cache_config.bandwidth;
+    for (int i = 0; i < count; i++) {
+      auto* host                 = hosts[i];
+      const std::string readable = host->get_name() + ctx.storage_suffix;
+      host->add_disk(node_resource_name(ordinal, i, readable + "_cache", 'c'), bandwidth, bandwidth);
+      if ((features & NODE_NAME_MAP) != 0) {
+        name_map_file << node_resource_name(ordinal, i, readable + "_cache", 'c') << '\t' << readable << "_cache\n";
+      }
+    }
+    add_page_cache_factory(
+        node_cache_factory(hosts, first_position, ordinal, ctx.storage_suffix, plan.node_cache_config));
   }
 
   // Set gateway
   const std::string router_name = name + "_router";
-  cluster->set_gateway(cluster->add_router(router_name));
+  auto* router                  = cluster->add_router(router_name);
+  if (multi_rail) {
+    route_rails(ctx, count, plan.rail_policy, router);
+  }
+  cluster->set_gateway(router);
   cluster->seal();
+
+  // VMs of the cluster's pools, on the nodes just created
+  for (const auto& pool : plan.vm_pools) {
+    auto& vms = vm_pools[{name, pool.name}];
+    build_vm_pool(ctx, count, pool, vms);
+    for (auto* vm : vms) {
+      host_names.add_host(vm);
+    }
+  }
 }
 
 void create_inter_zone_links(sg4::NetZone* datacenter, const json& links_config)
@@ -172,6 +475,7 @@ void create_inter_zone_links(sg4::NetZone* datacenter, const json& links_config)
     const std::string latency   = link_cfg.value("latency", "0s");
     const auto* link = datacenter->add_link(link_name, bandwidth)->set_latency(latency);
     link_map[link_name] = link;
+    load_monitor.advance();
   }
 }
 
@@ -190,11 +494,13 @@ void create_routes(sg4::NetZone* datacenter, const json& routes_config)
     }
 
     datacenter->add_route(src_zone, dst_zone, route_links);
+    load_monitor.advance();
   }
 }
 
-void create_filesystems(const json& filesystems_config, const json& platform_config)
+size_t create_filesystems(const json& filesystems_config, const json& platform_config)
 {
+  size_t partition_count = 0;
   for (const auto& fs_cfg : filesystems_config) {
     const std::string fs_name            = fs_cfg["name"];
     const std::string mount_point_pattern = fs_cfg["mount_point"];
@@ -210,6 +516,8 @@ void create_filesystems(const json& filesystems_config, const json& platform_con
 
       auto* zone = zone_map[storage_system_name];
       fs->mount_partition(mount_point_pattern, storage_map[storage_name], size);
+      partition_count++;
+      load_monitor.advance();
       sgfs::FileSystem::register_file_system(zone, fs);
 
     } else if (fs_cfg.contains("cluster")) {
@@ -220,7 +528,7 @@ void create_filesystems(const json& filesystems_config, const json& platform_con
       std::string prefix, suffix, storage_base_name;
       int count = 0;
 
-      for (const auto& dc : platform_config["facilities"]) {
+      for_each_zone_config(platform_config["facilities"], [&](const json& dc) {
         if (dc.contains("clusters")) {
           for (const auto& cluster : dc["clusters"]) {
             if (cluster["name"] == cluster_name) {
@@ -234,12 +542,24 @@ void create_filesystems(const json& filesystems_config, const json& platform_con
             }
           }
         }
+      });
+
+      const size_t ordinal = cluster_ordinals[cluster_name];
+      auto* zone           = zone_map[cluster_name];
+      sgfs::FileSystem::register_file_system(zone, fs);
+
+      // Lazy filesystem: partitions are mounted on first use by materialize_partitions()
+      if (fs_cfg.value("lazy", false)) {
+        lazy_filesystems_by_cluster[cluster_name].push_back(lazy_filesystems.size());
+        lazy_filesystems.push_back(
+            {fs, ordinal, prefix, suffix, storage_base_name, mount_point_pattern, size, std::vector<bool>(count)});
+        continue;
       }
 
       // Create partition for each node
       for (int i = 0; i < count; i++) {
         std::string hostname     = prefix + std::to_string(i) + suffix;
-        std::string storage_name = hostname + "_" + storage_base_name;
+        std::string storage_name = node_resource_name(ordinal, i, hostname + "_" + storage_base_name, 's');
 
         // Replace {hostname} in mount point pattern
         std::string mount_point = mount_point_pattern;
@@ -249,64 +569,327 @@ void create_filesystems(const json& filesystems_config, const json& platform_con
         }
 
         fs->mount_partition(mount_point, storage_map[storage_name], size);
+        load_monitor.advance();
       }
+      partition_count += count;
+    }
+  }
+  return partition_count;
+}
 
-      auto* zone = zone_map[cluster_name];
-      sgfs::FileSystem::register_file_system(zone, fs);
+// Index of a cluster node from its name (prefix<i>suffix), or -1 if the name does not match
+long node_index(const std::string& hostname, const std::string& prefix, const std::string& suffix)
+{
+  if (hostname.size() <= prefix.size() + suffix.size() || hostname.compare(0, prefix.size(), prefix) != 0 ||
+      hostname.compare(hostname.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return -1;
+  }
+  const std::string digits = hostname.substr(prefix.size(), hostname.size() - prefix.size() - suffix.size());
+  if (digits.find_first_not_of("0123456789") != std::string::npos) {
+    return -1;
+  }
+  return std::stol(digits);
+}
+
+size_t materialize_partitions(const sg4::Host* host)
+{
+  if (host == nullptr) {
+    return 0;
+  }
+  auto by_cluster = lazy_filesystems_by_cluster.find(host->get_englobing_zone()->get_name());
+  if (by_cluster == lazy_filesystems_by_cluster.end()) {
+    return 0;
+  }
+
+  size_t mounted = 0;
+  const std::string& hostname = host->get_name();
+  for (size_t index : by_cluster->second) {
+    auto& lazy = lazy_filesystems[index];
+
+    const long i = node_index(hostname, lazy.prefix, lazy.suffix);
+    if (i < 0 || static_cast<size_t>(i) >= lazy.mounted.size() || lazy.mounted[i]) {
+      continue;
+    }
+    lazy.mounted[i] = true;
+
+    const std::string readable     = hostname + "_" + lazy.storage_base_name;
+    const std::string storage_name = node_resource_name(lazy.ordinal, i, readable, 's');
+    auto& storage                  = storage_map[storage_name];
+    if (!storage) {
+      const std::string disk_name = node_resource_name(lazy.ordinal, i, readable + "_disk", 'k');
+      for (auto* disk : host->get_disks()) {
+        if (disk->get_name() == disk_name) {
+          storage = sgfs::OneDiskStorage::create(storage_name, disk);
+        }
+      }
+      if (!storage) {
+        throw std::runtime_error("Host " + hostname + " has no disk " + disk_name + " for lazy filesystem " +
+                                 lazy.fs->get_name());
+      }
     }
+
+    std::string mount_point = lazy.mount_point_pattern;
+    size_t pos;
+    while ((pos = mount_point.find("{hostname}")) != std::string::npos) {
+      mount_point.replace(pos, 10, hostname);
+    }
+    lazy.fs->mount_partition(mount_point, storage, lazy.size);
+    mounted++;
   }
+  return mounted;
 }
 
-void load_platform(const sg4::Engine& e)
+const std::vector<sg4::VirtualMachine*>& vm_pool(const std::string& cluster, const std::string& pool)
 {
-  // Load configuration
-  std::string config_path = get_config_path();
-  std::ifstream config_file(config_path);
-  if (!config_file.is_open()) {
-    throw std::runtime_error("Cannot open config file: " + config_path);
+  auto it = vm_pools.find({cluster, pool});
+  if (it == vm_pools.end()) {
+    throw std::runtime_error("Unknown VM pool " + pool + " of cluster " + cluster);
+  }
+  return it->second;
+}
+
+const std::vector<sg4::Host*>& hosts_by_locality()
+{
+  return locality_hosts;
+}
+
+sg4::Host* lookup_host(std::string_view name)
+{
+  return host_names.find(name);
+}
+
+const std::unordered_map<std::string, std::string>* host_properties(const sg4::Host* host)
+{
+  return node_property_sets.find(host_names.position(host->get_name()));
+}
+
+// Facility or nested zone: storage systems, clusters, graph zones and sub-zones, joined by links and routes.
+// Facilities default to Full routing; "routing" may also be Floyd or Dijkstra, whose routes are then hops
+// between child zones that SimGrid chains into paths.
+sg4::NetZone* create_zone(sg4::NetZone* parent, const json& zone_config, const PlatformPlan& plan)
+{
+  const std::string name    = zone_config["name"];
+  const std::string routing = zone_config.value("routing", "Full");
+  sg4::NetZone* zone;
+  if (routing == "Full") {
+    zone = parent->add_netzone_full(name);
+  } else if (routing == "Floyd") {
+    zone = parent->add_netzone_floyd(name);
+  } else if (routing == "Dijkstra") {
+    zone = parent->add_netzone_dijkstra(name, true);
+  } else {
+    throw std::runtime_error("Unknown routing '" + routing + "' for zone " + name +
+                             " (expected Full, Floyd or Dijkstra)");
   }
+  zone_map[name] = zone;
 
-  json config = json::parse(config_file);
+  // Create storage system zones
+  if (zone_config.contains("storage_systems")) {
+    auto phase = load_monitor.phase("storage_systems");
+    for (const auto& storage_cfg : zone_config["storage_systems"]) {
+      create_storage_system_zone(zone, storage_cfg);
+    }
+  }
 
-  // Process each facility (always uses Full routing)
-  for (const auto& dc_config : config["facilities"]) {
-    const std::string dc_name    = dc_config["name"];
-    sg4::NetZone* datacenter     = e.get_netzone_root()->add_netzone_full(dc_name);
-    zone_map[dc_name] = datacenter;
-
-    // Create storage system zones
-    if (dc_config.contains("storage_systems")) {
-      for (const auto& storage_cfg : dc_config["storage_systems"]) {
-        create_storage_system_zone(datacenter, storage_cfg);
+  // Create cluster zones
+  if (zone_config.contains("clusters")) {
+    auto phase = load_monitor.phase("clusters");
+    for (const auto& cluster_cfg : zone_config["clusters"]) {
+      create_cluster_zone(zone, cluster_cfg, plan.clusters.at(cluster_cfg["name"].get<std::string>()));
+    }
+  }
+
+  // Create graph zones (topology read from external node and edge files)
+  if (zone_config.contains("graphs")) {
+    auto phase = load_monitor.phase("graphs");
+    for (const auto& graph_cfg : zone_config["graphs"]) {
+      const std::string graph_name = graph_cfg["name"];
+      const size_t first_host      = locality_hosts.size();
+      zone_map[graph_name]         = create_graph_zone(zone, graph_cfg, plan.config_dir, &locality_hosts);
+      for (size_t i = first_host; i < locality_hosts.size(); i++) {
+        host_names.add_host(locality_hosts[i]);
       }
+      load_monitor.advance();
     }
+  }
+
+  // Create nested zones (campus, building, room, ...)
+  if (zone_config.contains("zones")) {
+    for (const auto& child_cfg : zone_config["zones"]) {
+      create_zone(zone, child_cfg, plan);
+    }
+  }
+
+  // Create inter-zone links
+  if (zone_config.contains("links")) {
+    auto phase = load_monitor.phase("links");
+    create_inter_zone_links(zone, zone_config["links"]);
+  }
+
+  // Create routes between zones
+  if (zone_config.contains("routes")) {
+    auto phase = load_monitor.phase("routes");
+    create_routes(zone, zone_config["routes"]);
+  }
+
+  // Add the remaining routes, computed from the interconnect graph when planning (see interconnect.hpp)
+  if (zone_config.contains("interconnect")) {
+    auto phase = load_monitor.phase("interconnect");
+    create_routes(zone, plan.interconnect_routes.at(name));
+  }
+
+  // Add gateway router for routing to and from the parent zone
+  const std::string router_name = name + "_router";
+  zone->set_gateway(zone->add_router(router_name));
+
+  zone->seal();
+  return zone;
+}
+
+// Number of objects each phase of load_platform() creates, so that progress can be reported as a fraction
+std::map<std::string, size_t> count_phase_objects(const json& config)
+{
+  std::map<std::string, size_t> totals;
+  std::map<std::string, size_t> cluster_sizes;
+  auto count_common = [&totals](const json& zone_config) {
+    if (zone_config.contains("storage_systems"))
+      totals["storage_systems"] += zone_config["storage_systems"].size();
+    if (zone_config.contains("links"))
+      totals["links"] += zone_config["links"].size();
+    if (zone_config.contains("routes"))
+      totals["routes"] += zone_config["routes"].size();
+  };
 
-    // Create cluster zones
+  for_each_zone_config(config["facilities"], [&](const json& dc_config) {
+    count_common(dc_config);
     if (dc_config.contains("clusters")) {
       for (const auto& cluster_cfg : dc_config["clusters"]) {
-        create_cluster_zone(datacenter, cluster_cfg);
+        size_t count = cluster_cfg["count"].get<size_t>();
+        totals["clusters"] += count + count_vms(cluster_cfg);
+        cluster_sizes[cluster_cfg["name"].get<std::string>()] = count;
       }
     }
+    if (dc_config.contains("graphs"))
+      totals["graphs"] += dc_config["graphs"].size();
+  });
+  count_common(config);
 
-    // Create inter-zone links
-    if (dc_config.contains("links")) {
-      create_inter_zone_links(datacenter, dc_config["links"]);
+  if (config.contains("filesystems")) {
+    for (const auto& fs_cfg : config["filesystems"]) {
+      if (fs_cfg.contains("storage_system"))
+        totals["filesystems"] += 1;
+      else if (fs_cfg.contains("cluster") && !fs_cfg.value("lazy", false))
+        totals["filesystems"] += cluster_sizes[fs_cfg["cluster"].get<std::string>()];
     }
+  }
+  return totals;
+}
 
-    // Create routes between zones
-    if (dc_config.contains("routes")) {
-      create_routes(datacenter, dc_config["routes"]);
+LinkMetrics config_link_metrics(const json& zone_config, const std::string& link_name)
+{
+  if (zone_config.contains("links")) {
+    for (const auto& link_cfg : zone_config["links"]) {
+      if (link_cfg["name"] == link_name) {
+        return {xbt_parse_get_bandwidth(link_name, 0, link_cfg["bandwidth"], "bandwidth"),
+                xbt_parse_get_time(link_name, 0, link_cfg.value("latency", "0s"), "latency")};
+      }
     }
+  }
+  throw std::runtime_error("Unknown link '" + link_name + "' in interconnect");
+}
+
+// Read, expand, validate and plan the configuration. SimGrid is not touched, so this may run in any thread.
+std::shared_ptr<const PlatformPlan> plan_platform(const std::string& config_path)
+{
+  auto plan        = std::make_shared<PlatformPlan>();
+  plan->config_dir = std::filesystem::path(config_path).parent_path();
 
-    // Add gateway router for inter-facility routing
-    const std::string router_name = dc_name + "_router";
-    datacenter->set_gateway(datacenter->add_router(router_name));
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    throw std::runtime_error("Cannot open config file: " + config_path);
+  }
+  plan->config       = expand_config(json::parse(config_file));
+  const json& config = plan->config;
+  plan->totals       = count_phase_objects(config);
 
-    datacenter->seal();
+  // Naming of per-node cluster resources
+  const std::string naming = config.value("naming", "readable");
+  if (naming == "compact") {
+    plan->naming = NodeNaming::COMPACT;
+  } else if (naming != "readable") {
+    throw std::runtime_error("Unknown naming '" + naming + "' in " + config_path + " (expected readable or compact)");
+  }
+  const std::string host_props = config.value("host_properties", "copy");
+  if (host_props == "shared") {
+    plan->share_host_properties = true;
+  } else if (host_props != "copy") {
+    throw std::runtime_error("Unknown host_properties '" + host_props + "' in " + config_path +
+                             " (expected copy or shared)");
+  }
+
+  plan->lazy_storage_clusters = find_lazy_storage_clusters(config);
+
+  // Optionally make sure every leaf zone can reach every other one before building anything
+  if (const char* check = std::getenv("PLATFORM_CHECK_ROUTES"); check && std::string(check) != "0") {
+    RouteCheckReport report = check_routes(config);
+    report.print(std::cerr);
+    if (!report.ok()) {
+      throw std::runtime_error("Route check failed for " + config_path + ": " + std::to_string(report.issues.size()) +
+                               " issue(s)");
+    }
+  }
+
+  for_each_zone_config(config["facilities"], [&plan](const json& zone_config) {
+    if (zone_config.contains("clusters")) {
+      for (const auto& cluster_cfg : zone_config["clusters"]) {
+        plan->clusters[cluster_cfg["name"].get<std::string>()] =
+            plan_cluster(cluster_cfg, plan->lazy_storage_clusters);
+      }
+    }
+    if (zone_config.contains("interconnect")) {
+      auto metrics = [&zone_config](const std::string& link_name) {
+        return config_link_metrics(zone_config, link_name);
+      };
+      plan->interconnect_routes[zone_config["name"].get<std::string>()] =
+          to_routes_config(compute_interconnect_routes(zone_config, metrics));
+    }
+  });
+  return plan;
+}
+
+// Build the planned platform; this is the part of load_platform() that runs on the maestro thread
+void build_platform(const sg4::Engine& e, const PlatformPlan& plan)
+{
+  const json& config                      = plan.config;
+  const std::filesystem::path& config_dir = plan.config_dir;
+  load_monitor.set_totals(plan.totals);
+
+  share_host_properties = plan.share_host_properties;
+
+  // Where to list the compact names of per-node cluster resources
+  node_naming = plan.naming;
+  if (node_naming == NodeNaming::COMPACT && config.contains("name_map")) {
+    std::filesystem::path map_path = config["name_map"].get<std::string>();
+    if (map_path.is_relative()) {
+      map_path = config_dir / map_path;
+    }
+    name_map_file.open(map_path);
+    if (!name_map_file.is_open()) {
+      throw std::runtime_error("Cannot write name map: " + map_path.string());
+    }
+    name_map_file << "# compact name\treadable name\n";
+  }
+
+  lazy_storage_clusters = plan.lazy_storage_clusters;
+
+  // Process each facility, and the zones nested in it
+  for (const auto& dc_config : config["facilities"]) {
+    create_zone(e.get_netzone_root(), dc_config, plan);
   }
 
   // Create top-level storage system zones (shared across facilities)
   if (config.contains("storage_systems")) {
+    auto phase = load_monitor.phase("storage_systems");
     for (const auto& storage_cfg : config["storage_systems"]) {
       create_storage_system_zone(e.get_netzone_root(), storage_cfg);
     }
@@ -314,17 +897,20 @@ void load_platform(const sg4::Engine& e)
 
   // Create top-level inter-facility links
   if (config.contains("links")) {
+    auto phase = load_monitor.phase("links");
     for (const auto& link_cfg : config["links"]) {
       const std::string link_name = link_cfg["name"];
       const std::string bandwidth = link_cfg["bandwidth"];
       const std::string latency   = link_cfg.value("latency", "0s");
       const auto* link = e.get_netzone_root()->add_link(link_name, bandwidth)->set_latency(latency);
       link_map[link_name] = link;
+      load_monitor.advance();
     }
   }
 
   // Create top-level routes (between facilities or between facility and shared storage)
   if (config.contains("routes")) {
+    auto phase = load_monitor.phase("routes");
     for (const auto& route_cfg : config["routes"]) {
       const std::string src_name = route_cfg["src"];
       const std::string dst_name = route_cfg["dst"];
@@ -337,11 +923,399 @@ void load_platform(const sg4::Engine& e)
       }
 
       e.get_netzone_root()->add_route(src_zone, dst_zone, route_links, true);  // symmetric = true
+      load_monitor.advance();
     }
   }
 
   // Create filesystems (mount partitions)
   if (config.contains("filesystems")) {
-    create_filesystems(config["filesystems"], config);
+    auto phase = load_monitor.phase("filesystems");
+    phase.add_objects(create_filesystems(config["filesystems"], config));
+  }
+
+  // Nodes get their lazy partitions when the first actor starts on them
+  if (!lazy_filesystems.empty()) {
+    static bool hooked = false;
+    if (!hooked) {
+      sg4::Actor::on_creation_cb([](sg4::Actor& actor) { materialize_partitions(actor.get_host()); });
+      hooked = true;
+    }
+  }
+
+  // Topology index for tools that do not load the platform (see topology_index.hpp)
+  if (config.contains("topology_index")) {
+    auto phase                       = load_monitor.phase("topology_index");
+    std::filesystem::path index_path = config["topology_index"].get<std::string>();
+    if (index_path.is_relative()) {
+      index_path = config_dir / index_path;
+    }
+    write_topology_index(config, config_dir, index_path.string());
+  }
+
+  if (name_map_file.is_open()) {
+    name_map_file.close();
+  }
+  load_monitor.finish(std::cerr);
+}
+
+void load_platform(const sg4::Engine& e)
+{
+  load_monitor.start(e);
+  std::shared_ptr<const PlatformPlan> plan;
+  {
+    auto phase = load_monitor.phase("parse");
+    plan       = plan_platform(get_config_path());
+  }
+  build_platform(e, *plan);
+}
+
+PlatformLoad begin_load(const std::string& config_path)
+{
+  return PlatformLoad(
+      std::async(std::launch::async, plan_platform, config_path.empty() ? get_config_path() : config_path));
+}
+
+void PlatformLoad::commit(const sg4::Engine& e)
+{
+  if (!plan_.valid()) {
+    throw std::logic_error("PlatformLoad::commit() called twice");
+  }
+  load_monitor.start(e);
+  std::shared_ptr<const PlatformPlan> plan;
+  {
+    // Only what is left of the background work when the simulator commits
+    auto phase = load_monitor.phase("parse");
+    plan       = plan_.get();
+  }
+  build_platform(e, *plan);
+}
+
+// A field of a sweep point that differs from the loaded configuration, with the objects it maps to
+struct ParameterChange {
+  enum class Owner { LINK, STORAGE_SYSTEM, CLUSTER };
+  Owner owner;
+  std::string name;  // Of the link, storage system or cluster
+  std::string field; // In the owner's configuration, such as "node/private_link/bandwidth"
+  double base;       // Loaded value, in bytes/s, seconds or flop/s
+  double value;      // Value of the point
+};
+
+// Fields that run_parameter_sweep() can change on the built platform, by owner
+const std::map<ParameterChange::Owner, std::set<std::string>> sweep_fields = {
+    {ParameterChange::Owner::LINK, {"bandwidth", "latency"}},
+    {ParameterChange::Owner::STORAGE_SYSTEM, {"server_speed", "read_bandwidth", "write_bandwidth", "cache/bandwidth"}},
+    {ParameterChange::Owner::CLUSTER,
+     {"node/speed", "node/private_link/bandwidth", "node/private_link/latency", "node/loopback/bandwidth",
+      "node/loopback/latency", "backbone/bandwidth", "backbone/latency", "node/storage/read_bandwidth",
+      "node/storage/write_bandwidth", "node/storage/cache/bandwidth"}}};
+
+std::string join_path(const std::vector<std::string>& tokens, size_t first = 0)
+{
+  std::string path;
+  for (size_t i = first; i < tokens.size(); i++) {
+    path += (i == first ? "" : "/") + tokens[i];
+  }
+  return path;
+}
+
+// Paths of the values that differ between @p base and @p point, which must only differ by values
+void diff_values(const json& base, const json& point, std::vector<std::string>& path,
+                 std::vector<std::vector<std::string>>& changed)
+{
+  auto fail = [&path](const std::string& what) {
+    throw std::runtime_error("Sweep point " + what + " at /" + join_path(path) +
+                             ": only parameter values may change without a rebuild");
+  };
+  if (base.is_object() && point.is_object()) {
+    for (const auto& [key, value] : base.items()) {
+      if (!point.contains(key)) {
+        fail("removes '" + key + "'");
+      }
+    }
+    for (const auto& [key, value] : point.items()) {
+      if (!base.contains(key)) {
+        fail("adds '" + key + "'");
+      }
+      path.push_back(key);
+      diff_values(base[key], value, path, changed);
+      path.pop_back();
+    }
+  } else if (base.is_array() && point.is_array()) {
+    if (base.size() != point.size()) {
+      fail("changes the number of elements");
+    }
+    for (size_t i = 0; i < base.size(); i++) {
+      path.push_back(std::to_string(i));
+      diff_values(base[i], point[i], path, changed);
+      path.pop_back();
+    }
+  } else if (base.is_structured() || point.is_structured()) {
+    fail("changes the structure");
+  } else if (base != point) {
+    changed.push_back(path);
+  }
+}
+
+// Map a changed value to its owner: a link, storage system or cluster of a facility, a nested zone or the top level
+ParameterChange classify_change(const json& base, const std::vector<std::string>& path)
+{
+  size_t pos = 0;
+  if (path.size() > 2 && path[0] == "facilities") {
+    pos = 2;
+    while (pos + 2 < path.size() && path[pos] == "zones") {
+      pos += 2;
+    }
+  }
+  ParameterChange change{ParameterChange::Owner::LINK, "", "", 0, 0};
+  const bool owned = pos + 2 < path.size();
+  if (owned && path[pos] == "storage_systems") {
+    change.owner = ParameterChange::Owner::STORAGE_SYSTEM;
+  } else if (owned && path[pos] == "clusters") {
+    change.owner = ParameterChange::Owner::CLUSTER;
+  }
+  change.field = join_path(path, pos + 2);
+  if (!owned || (path[pos] != "links" && path[pos] != "storage_systems" && path[pos] != "clusters") ||
+      sweep_fields.at(change.owner).count(change.field) == 0) {
+    throw std::runtime_error("Sweep point changes /" + join_path(path) +
+                             ", which is not a link, storage system or cluster parameter settable without a rebuild");
+  }
+
+  const json* owner = &base;
+  for (size_t i = 0; i < pos + 2; i++) {
+    owner = owner->is_array() ? &(*owner)[std::stoul(path[i])] : &(*owner)[path[i]];
+  }
+  change.name = (*owner)["name"];
+  if (change.owner == ParameterChange::Owner::CLUSTER && owner->value("rails", 1) > 1 &&
+      (change.field.rfind("node/private_link/", 0) == 0 || change.field.rfind("backbone/", 0) == 0)) {
+    throw std::runtime_error("Sweep point changes the " + change.field + " of multi-rail cluster " + change.name +
+                             ", which needs a rebuild");
+  }
+  return change;
+}
+
+// Value of a changed field, with its units parsed
+double parse_parameter(const std::string& field, const json& value)
+{
+  const std::string text = value.is_string() ? value.get<std::string>() : value.dump();
+  if (field.size() >= 5 && field.compare(field.size() - 5, 5, "speed") == 0) {
+    return xbt_parse_get_speed(field, 0, text, "speed");
+  }
+  if (field.size() >= 7 && field.compare(field.size() - 7, 7, "latency") == 0) {
+    return xbt_parse_get_time(field, 0, text, "latency");
+  }
+  return xbt_parse_get_bandwidth(field, 0, text, "bandwidth");
+}
+
+// The changes of the sweep point @p point_path against the loaded configuration of @p plan
+std::vector<ParameterChange> plan_sweep_point(const PlatformPlan& plan, const std::string& point_path)
+{
+  const json& base = plan.config;
+  std::ifstream point_file(point_path);
+  if (!point_file.is_open()) {
+    throw std::runtime_error("Cannot open sweep point: " + point_path);
+  }
+  const json point = expand_config(json::parse(point_file));
+
+  std::vector<std::string> path;
+  std::vector<std::vector<std::string>> changed;
+  try {
+    diff_values(base, point, path, changed);
+  } catch (const std::runtime_error& error) {
+    throw std::runtime_error(point_path + ": " + error.what());
+  }
+  std::vector<ParameterChange> changes;
+  for (const auto& changed_path : changed) {
+    const json* base_value  = &base;
+    const json* point_value = &point;
+    for (const auto& token : changed_path) {
+      const bool index = base_value->is_array();
+      base_value       = index ? &(*base_value)[std::stoul(token)] : &(*base_value)[token];
+      point_value      = index ? &(*point_value)[std::stoul(token)] : &(*point_value)[token];
+    }
+    ParameterChange change = classify_change(base, changed_path);
+    change.base            = parse_parameter(change.field, *base_value);
+    change.value           = parse_parameter(change.field, *point_value);
+    changes.push_back(std::move(change));
+  }
+
+  // Interconnect routes were computed from the loaded link metrics: a point may only change links whose new
+  // values induce the same routes
+  std::set<std::string> changed_links;
+  for (const auto& change : changes) {
+    if (change.owner == ParameterChange::Owner::LINK) {
+      changed_links.insert(change.name);
+    }
+  }
+  if (!changed_links.empty()) {
+    for_each_zone_config(point["facilities"], [&](const json& zone_config) {
+      if (!zone_config.contains("interconnect")) {
+        return;
+      }
+      const auto& edges = zone_config["interconnect"]["edges"];
+      if (std::none_of(edges.begin(), edges.end(),
+                       [&changed_links](const json& edge) { return changed_links.count(edge["link"]) != 0; })) {
+        return;
+      }
+      const std::string name = zone_config["name"];
+      auto metrics           = [&zone_config](const std::string& link_name) {
+        return config_link_metrics(zone_config, link_name);
+      };
+      if (to_routes_config(compute_interconnect_routes(zone_config, metrics)) != plan.interconnect_routes.at(name)) {
+        throw std::runtime_error(point_path + ": the changed links change the interconnect routes of zone " + name +
+                                 ", which needs a rebuild");
+      }
+    });
+  }
+  return changes;
+}
+
+// Set a changed field on the objects it maps to, with the s4u setters of the built platform
+void apply_parameter(const ParameterChange& change)
+{
+  const std::string& field = change.field;
+  auto set_link            = [&change](const std::string& link_name) {
+    auto* link = sg4::Link::by_name(link_name);
+    if (change.field.compare(change.field.size() - 7, 7, "latency") == 0) {
+      link->set_latency(change.value);
+    } else {
+      link->set_bandwidth(change.value);
+    }
+  };
+  auto set_disk = [&change](sg4::Disk* disk) {
+    if (change.field.find("write_") == std::string::npos) {
+      disk->set_read_bandwidth(change.value);
+    }
+    if (change.field.find("read_") == std::string::npos) {
+      disk->set_write_bandwidth(change.value);
+    }
+  };
+  auto set_speed = [&change](sg4::Host* host) {
+    const auto& speeds = sweep_speeds.at(change.name);
+    host->set_pstate(std::find(speeds.begin(), speeds.end(), change.value) - speeds.begin());
+  };
+
+  switch (change.owner) {
+    case ParameterChange::Owner::LINK:
+      set_link(change.name);
+      return;
+
+    case ParameterChange::Owner::STORAGE_SYSTEM: {
+      auto* server = sg4::Host::by_name(change.name + "_server");
+      if (field == "server_speed") {
+        set_speed(server);
+        return;
+      }
+      // The cache memory is the server's disk named after the storage; the other disks back the storage
+      const std::string cache_name = change.name + "_storage_cache";
+      for (auto* disk : server->get_disks()) {
+        if ((disk->get_name() == cache_name) == (field == "cache/bandwidth")) {
+          set_disk(disk);
+        }
+      }
+      return;
+    }
+
+    case ParameterChange::Owner::CLUSTER:
+      break;
+  }
+
+  if (field.rfind("backbone/", 0) == 0) {
+    set_link(change.name + "_backbone");
+    return;
+  }
+  const auto& hosts    = cluster_nodes.at(change.name);
+  const size_t ordinal = cluster_ordinals.at(change.name);
+  for (size_t i = 0; i < hosts.size(); i++) {
+    const int index             = static_cast<int>(i);
+    const std::string& hostname = hosts[i]->get_name();
+    if (field == "node/speed") {
+      set_speed(hosts[i]);
+    } else if (field.rfind("node/private_link/", 0) == 0) {
+      set_link(node_resource_name(ordinal, index, hostname + "_LinkUP", 'u'));
+      set_link(node_resource_name(ordinal, index, hostname + "_LinkDOWN", 'd'));
+    } else if (field.rfind("node/loopback/", 0) == 0) {
+      set_link(node_resource_name(ordinal, index, hostname + "_loopback", 'l'));
+    } else {
+      // Node storage disk first, then its cache memory
+      set_disk(hosts[i]->get_disks().at(field == "node/storage/cache/bandwidth" ? 1 : 0));
+    }
+  }
+}
+
+std::vector<int> run_parameter_sweep(const sg4::Engine& e, const std::vector<std::string>& point_paths,
+                                     const std::function<void(size_t point)>& simulate, unsigned jobs)
+{
+  load_monitor.start(e);
+  std::shared_ptr<const PlatformPlan> plan;
+  std::vector<std::vector<ParameterChange>> points;
+  {
+    auto phase = load_monitor.phase("parse");
+    plan       = plan_platform(get_config_path());
+    for (const auto& point_path : point_paths) {
+      points.push_back(plan_sweep_point(*plan, point_path));
+    }
+
+    // Host speeds cannot change once the platform is sealed, so the hosts get every speed of the sweep as a
+    // pstate (the loaded speed as pstate 0) and the points switch pstates
+    for (const auto& changes : points) {
+      for (const auto& change : changes) {
+        if (change.field != "node/speed" && change.field != "server_speed") {
+          continue;
+        }
+        auto& speeds = sweep_speeds[change.name];
+        if (speeds.empty()) {
+          speeds.push_back(change.base);
+        }
+        if (std::find(speeds.begin(), speeds.end(), change.value) == speeds.end()) {
+          speeds.push_back(change.value);
+        }
+      }
+    }
+  }
+  build_platform(e, *plan);
+
+  // One forked child per point, on a copy of the built platform, at most `jobs` at a time
+  std::vector<int> statuses(points.size(), -1);
+  std::map<pid_t, size_t> running;
+  size_t next = 0;
+  while (next < points.size() || !running.empty()) {
+    while (next < points.size() && running.size() < std::max(jobs, 1U)) {
+      std::cout.flush();
+      std::cerr.flush();
+      pid_t pid = fork();
+      if (pid < 0) {
+        throw std::runtime_error(std::string("fork: ") + strerror(errno));
+      }
+      if (pid == 0) {
+        int status = 0;
+        try {
+          for (const auto& change : points[next]) {
+            apply_parameter(change);
+          }
+          simulate(next);
+        } catch (const std::exception& error) {
+          std::cerr << "Sweep point " << point_paths[next] << ": " << error.what() << "\n";
+          status = 1;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        _exit(status); // The engine teardown is of no interest to the parent
+      }
+      running[pid] = next;
+      next++;
+    }
+
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      throw std::runtime_error(std::string("waitpid: ") + strerror(errno));
+    }
+    auto it = running.find(pid);
+    if (it == running.end()) {
+      continue;
+    }
+    statuses[it->second] = WIFSIGNALED(status) ? 128 + WTERMSIG(status) : WEXITSTATUS(status);
+    running.erase(it);
   }
+  return statuses;
 }
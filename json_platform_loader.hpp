@@ -0,0 +1,139 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file json_platform_loader.hpp
+ * @brief Public API of libplatform.so, for simulators linking against it.
+ *
+ * Simulators that only pass libplatform.so to SimGrid (--cfg=platf:...) do not
+ * need this header; everything below is also reachable through environment
+ * variables (see README.md).
+ */
+
+#ifndef JSON_PLATFORM_LOADER_HPP
+#define JSON_PLATFORM_LOADER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace simgrid::s4u {
+class Engine;
+class Host;
+class VirtualMachine;
+}
+
+/** Build the platform described by the JSON configuration (see get_config_path() for its location) */
+extern "C" void load_platform(const simgrid::s4u::Engine& e);
+
+struct PlatformPlan;
+
+/**
+ * Platform load started by begin_load(). The configuration is read, expanded, validated and planned
+ * (units parsed, host properties resolved, interconnect routes computed) in a background thread while
+ * the simulator does something else; commit() then builds the SimGrid platform.
+ */
+class PlatformLoad {
+  std::future<std::shared_ptr<const PlatformPlan>> plan_;
+
+public:
+  explicit PlatformLoad(std::future<std::shared_ptr<const PlatformPlan>> plan) : plan_(std::move(plan)) {}
+  /** Whether the background work is over, so that commit() will not wait for it */
+  bool ready() const { return plan_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+  /**
+   * Wait for the background work, then build the platform in @p e. Call it once, from the maestro thread
+   * before Engine::run(). Errors of the background work (unreadable or invalid configuration, failed route
+   * check) are thrown here.
+   */
+  void commit(const simgrid::s4u::Engine& e);
+};
+
+/** Start loading @p config_path (get_config_path()'s choice when empty); destroying the result waits for it */
+PlatformLoad begin_load(const std::string& config_path = "");
+
+/**
+ * Mount the partitions that @p host has in lazy cluster filesystems ("lazy": true), if not done yet.
+ * This happens automatically when an actor is created on the host; call it before accessing the
+ * partition of a host where no actor runs. Returns the number of partitions mounted by this call.
+ */
+size_t materialize_partitions(const simgrid::s4u::Host* host);
+
+/**
+ * VMs of the pool @p pool of cluster @p cluster ("vm_pools"), node after node: VM @c vm of node @c node
+ * is at node * per_host + vm, as in the topology index. Throws std::runtime_error for unknown pools.
+ */
+const std::vector<simgrid::s4u::VirtualMachine*>& vm_pool(const std::string& cluster, const std::string& pool);
+
+/**
+ * All the hosts (not the VMs) in topology-locality order: zone tree order (a zone's storage servers, cluster
+ * nodes and graph hosts, then its sub-zones; top-level storage servers last), cluster nodes grouped by their
+ * "rack" property, racks in the order of their first node, and by index within a rack. Contiguous ranges
+ * of this array are topologically compact, so schedulers can allocate from it without sorting. The
+ * topology index stores the same order (TopologyIndex::locality_order()).
+ */
+const std::vector<simgrid::s4u::Host*>& hosts_by_locality();
+
+/**
+ * Host or VM named @p name, or nullptr, in time independent of the number of hosts and without allocating:
+ * cluster node names are split into prefix, index and suffix rather than hashed (see host_names.hpp). Meant
+ * for trace replays, where Engine::host_by_name() would be called for every event. Only knows the hosts
+ * created by the loader.
+ */
+simgrid::s4u::Host* lookup_host(std::string_view name);
+
+/**
+ * Properties that the cluster configuration gives to node @p host, or nullptr for hosts without any. The set
+ * is shared by all the nodes using it (see property_sets.hpp). With "host_properties": "shared", this is the
+ * only way to read them: the loader does not copy them into each host, so Host::get_property() returns nullptr.
+ */
+const std::unordered_map<std::string, std::string>* host_properties(const simgrid::s4u::Host* host);
+
+/**
+ * Parameter sweep over one built platform. Builds the platform once, as load_platform() does, then runs each
+ * point of @p point_paths in a forked child, at most @p jobs at a time. A point is a configuration that only
+ * differs from the loaded one by link bandwidths and latencies, host speeds and disk bandwidths: the child sets
+ * the differing values on the objects they map to, with the s4u setters, then calls @p simulate with the index
+ * of the point, which creates the actors and runs the engine. Any other difference is thrown before building.
+ * Returns the exit status of each point's child: 0 when @p simulate returned, 1 when it threw, 128 + the signal
+ * when the child was killed.
+ */
+std::vector<int> run_parameter_sweep(const simgrid::s4u::Engine& e, const std::vector<std::string>& point_paths,
+                                     const std::function<void(size_t point)>& simulate, unsigned jobs = 1);
+
+/** Snapshot of the progress of load_platform(), passed to the progress callback */
+struct LoadProgress {
+  std::string phase;   // Current phase (parse, storage_systems, clusters, graphs, links, routes, filesystems)
+  size_t done  = 0;    // Objects of this phase created so far, over all facilities
+  size_t total = 0;    // Objects expected in this phase
+  double rate  = 0.0;  // Objects created per second in this phase
+  double eta   = -1.0; // Estimated seconds left in this phase (negative when unknown)
+  double elapsed = 0.0; // Seconds since the beginning of load_platform()
+  size_t rss     = 0;   // Resident set size of the process, in bytes
+};
+
+/** Called periodically during load_platform(). Returning false cancels the load, which then throws LoadAborted. */
+using ProgressCallback = std::function<bool(const LoadProgress&)>;
+
+/** Install (or remove, with an empty function) the progress callback, called at most every @p interval seconds */
+void set_progress_callback(ProgressCallback callback, double interval = 1.0);
+
+/** Thrown by load_platform() when the load is cancelled or exceeds PLATFORM_MAX_SECONDS or PLATFORM_MAX_RSS */
+class LoadAborted : public std::runtime_error {
+  LoadProgress progress_;
+
+public:
+  LoadAborted(const std::string& what, const LoadProgress& progress) : std::runtime_error(what), progress_(progress) {}
+  /** Where the load was when it was aborted */
+  const LoadProgress& progress() const { return progress_; }
+};
+
+#endif
@@ -0,0 +1,275 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "load_monitor.hpp"
+
+LoadMonitor load_monitor;
+
+void set_progress_callback(ProgressCallback callback, double interval)
+{
+  load_monitor.set_callback(std::move(callback), interval);
+}
+
+namespace {
+
+// Number of advance() units between two looks at the clock: small enough to honor budgets and print
+// a smooth progress line, large enough to keep the cost negligible next to the creation of an object.
+constexpr size_t CHECK_STRIDE = 256;
+// Minimum delay between two refreshes of the progress line
+constexpr double LINE_INTERVAL = 0.25;
+
+bool env_flag(const char* name)
+{
+  const char* value = std::getenv(name);
+  return value && std::string(value) != "0";
+}
+
+double parse_seconds(const char* name, const char* value)
+{
+  char* end    = nullptr;
+  double limit = std::strtod(value, &end);
+  if (end == value || *end != '\0' || limit < 0)
+    throw std::runtime_error(std::string("Invalid ") + name + " (expected seconds): " + value);
+  return limit;
+}
+
+// Accept plain bytes or a K/M/G/T suffix (powers of 1024), optionally followed by "B" or "iB"
+size_t parse_bytes(const char* name, const char* value)
+{
+  char* end    = nullptr;
+  double limit = std::strtod(value, &end);
+  if (end == value || limit < 0)
+    throw std::runtime_error(std::string("Invalid ") + name + " (expected bytes, e.g. 64G): " + value);
+  std::string unit(end);
+  if (not unit.empty()) {
+    const std::string prefixes = "KMGT";
+    auto pos                   = prefixes.find(static_cast<char>(std::toupper(static_cast<unsigned char>(unit[0]))));
+    std::string rest           = unit.substr(pos == std::string::npos ? 0 : 1);
+    if (rest != "" && rest != "B" && rest != "iB")
+      throw std::runtime_error(std::string("Invalid ") + name + " (expected bytes, e.g. 64G): " + value);
+    if (pos != std::string::npos)
+      for (size_t i = 0; i <= pos; i++)
+        limit *= 1024;
+  }
+  return static_cast<size_t>(limit);
+}
+
+size_t resident_bytes()
+{
+  std::ifstream statm("/proc/self/statm");
+  size_t pages    = 0;
+  size_t resident = 0;
+  if (not(statm >> pages >> resident))
+    return 0;
+  return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::string format_duration(double seconds)
+{
+  std::ostringstream oss;
+  if (seconds < 0)
+    oss << "?";
+  else if (seconds < 60)
+    oss << std::fixed << std::setprecision(1) << seconds << "s";
+  else if (seconds < 3600)
+    oss << static_cast<long>(seconds) / 60 << "m" << std::setw(2) << std::setfill('0') << static_cast<long>(seconds) % 60
+        << "s";
+  else
+    oss << static_cast<long>(seconds) / 3600 << "h" << std::setw(2) << std::setfill('0')
+        << static_cast<long>(seconds) % 3600 / 60 << "m";
+  return oss.str();
+}
+
+std::string format_progress(const LoadProgress& progress)
+{
+  std::ostringstream oss;
+  oss << "[platform] " << progress.phase << ": " << progress.done;
+  if (progress.total > 0)
+    oss << "/" << progress.total << " (" << std::fixed << std::setprecision(1)
+        << 100.0 * static_cast<double>(progress.done) / static_cast<double>(progress.total) << "%)";
+  oss << std::fixed << std::setprecision(0) << ", " << progress.rate << "/s, ETA " << format_duration(progress.eta)
+      << ", elapsed " << format_duration(progress.elapsed) << ", RSS " << progress.rss / (1024 * 1024) << " MB";
+  return oss.str();
+}
+
+} // namespace
+
+LoadMonitor::PhaseStats& LoadMonitor::stats(const std::string& name)
+{
+  for (auto& phase : phases_)
+    if (phase.name == name)
+      return phase;
+  PhaseStats phase;
+  phase.name = name;
+  if (auto it = totals_.find(name); it != totals_.end())
+    phase.total = it->second;
+  phases_.push_back(phase);
+  return phases_.back();
+}
+
+LoadProgress LoadMonitor::snapshot(Clock::time_point now) const
+{
+  LoadProgress progress;
+  progress.elapsed = std::chrono::duration<double>(now - load_start_).count();
+  progress.rss     = resident_bytes();
+  if (current_) {
+    double phase_seconds = current_->perf.seconds + std::chrono::duration<double>(now - segment_start_).count();
+    progress.phase       = current_->name;
+    progress.done        = done_;
+    progress.total       = current_->total;
+    progress.rate        = phase_seconds > 0 ? static_cast<double>(done_) / phase_seconds : 0.0;
+    if (progress.rate > 0 && progress.total >= progress.done)
+      progress.eta = static_cast<double>(progress.total - progress.done) / progress.rate;
+  }
+  return progress;
+}
+
+void LoadMonitor::check()
+{
+  next_check_       = done_ + CHECK_STRIDE;
+  auto now          = Clock::now();
+  LoadProgress prog = snapshot(now);
+
+  if (max_seconds_ > 0 && prog.elapsed > max_seconds_) {
+    std::ostringstream reason;
+    reason << "time budget exceeded (PLATFORM_MAX_SECONDS=" << max_seconds_ << ")";
+    abort(reason.str(), prog);
+  }
+  if (max_rss_ > 0 && prog.rss > max_rss_)
+    abort("memory budget exceeded (PLATFORM_MAX_RSS=" + std::to_string(max_rss_ / (1024 * 1024)) + " MB)", prog);
+
+  if (progress_line_ && std::chrono::duration<double>(now - last_line_).count() >= LINE_INTERVAL) {
+    std::cerr << "\r" << format_progress(prog) << "\033[K" << std::flush;
+    line_pending_ = true;
+    last_line_    = now;
+  }
+  if (callback_ && std::chrono::duration<double>(now - last_callback_).count() >= callback_interval_) {
+    last_callback_ = now;
+    if (not callback_(prog))
+      abort("cancelled by the progress callback", prog);
+  }
+}
+
+void LoadMonitor::abort(const std::string& reason, const LoadProgress& progress)
+{
+  if (line_pending_)
+    std::cerr << "\n";
+  line_pending_ = false;
+  std::cerr << "[platform] load aborted: " << reason << "\n" << format_progress(progress) << std::endl;
+  throw LoadAborted("Platform load aborted in phase '" + progress.phase + "': " + reason, progress);
+}
+
+LoadMonitor::Phase::Phase(LoadMonitor* monitor, const std::string& name) : monitor_(monitor)
+{
+  if (not monitor_)
+    return;
+  // Phases run once per facility resume where the previous facility stopped
+  monitor_->current_       = &monitor_->stats(name);
+  monitor_->done_          = monitor_->current_->done;
+  monitor_->segment_start_ = Clock::now();
+  monitor_->check();
+  start_objects_ = monitor_->engine_objects();
+  if (monitor_->counters_)
+    monitor_->counters_->start();
+}
+
+LoadMonitor::Phase::~Phase()
+{
+  if (not monitor_)
+    return;
+  auto& stats = *monitor_->current_;
+  if (monitor_->counters_)
+    stats.perf += monitor_->counters_->stop();
+  else
+    stats.perf.seconds += std::chrono::duration<double>(Clock::now() - monitor_->segment_start_).count();
+  stats.objects += monitor_->engine_objects() - start_objects_ + extra_objects_;
+  stats.done = monitor_->done_;
+  monitor_->current_    = nullptr;
+  monitor_->next_check_ = std::numeric_limits<size_t>::max();
+}
+
+void LoadMonitor::start(const simgrid::s4u::Engine& e)
+{
+  e_ = &e;
+  phases_.clear();
+  totals_.clear();
+  current_      = nullptr;
+  done_         = 0;
+  next_check_   = std::numeric_limits<size_t>::max();
+  line_pending_ = false;
+  counters_.reset();
+
+  if (env_flag("PLATFORM_TRACE"))
+    counters_ = std::make_unique<PerfCounters>();
+  progress_line_ = env_flag("PLATFORM_PROGRESS");
+  max_seconds_   = 0.0;
+  max_rss_       = 0;
+  if (const char* value = std::getenv("PLATFORM_MAX_SECONDS"); value && *value)
+    max_seconds_ = parse_seconds("PLATFORM_MAX_SECONDS", value);
+  if (const char* value = std::getenv("PLATFORM_MAX_RSS"); value && *value)
+    max_rss_ = parse_bytes("PLATFORM_MAX_RSS", value);
+
+  active_     = counters_ || progress_line_ || max_seconds_ > 0 || max_rss_ > 0 || callback_;
+  load_start_ = Clock::now();
+  last_line_  = load_start_;
+  // Let the callback see the first phase right away
+  last_callback_ = load_start_ - std::chrono::duration_cast<Clock::duration>(
+                                     std::chrono::duration<double>(callback_interval_));
+}
+
+void LoadMonitor::set_callback(ProgressCallback callback, double interval)
+{
+  callback_          = std::move(callback);
+  callback_interval_ = interval;
+}
+
+void LoadMonitor::finish(std::ostream& os)
+{
+  if (line_pending_) {
+    double elapsed = std::chrono::duration<double>(Clock::now() - load_start_).count();
+    os << "\r[platform] loaded in " << format_duration(elapsed) << ", RSS " << resident_bytes() / (1024 * 1024)
+       << " MB\033[K\n";
+    line_pending_ = false;
+  }
+  if (not counters_)
+    return;
+
+  auto counter    = [](long long value) { return value >= 0 ? std::to_string(value) : std::string("n/a"); };
+  auto per_object = [](long long value, size_t objects) {
+    std::ostringstream oss;
+    if (value >= 0 && objects > 0)
+      oss << std::fixed << std::setprecision(2) << static_cast<double>(value) / objects;
+    else
+      oss << "n/a";
+    return oss.str();
+  };
+
+  os << "[platform] " << std::left << std::setw(16) << "phase" << std::right << std::setw(10) << "time (s)"
+     << std::setw(10) << "objects" << std::setw(14) << "cycles" << std::setw(14) << "instructions" << std::setw(6)
+     << "IPC" << std::setw(14) << "LLC miss/obj" << std::setw(12) << "faults/obj" << "\n";
+  if (not counters_->available())
+    os << "[platform] hardware counters unavailable (see /proc/sys/kernel/perf_event_paranoid)\n";
+  for (const auto& phase : phases_) {
+    std::ostringstream ipc;
+    if (phase.perf.ipc() >= 0)
+      ipc << std::fixed << std::setprecision(2) << phase.perf.ipc();
+    else
+      ipc << "n/a";
+    os << "[platform] " << std::left << std::setw(16) << phase.name << std::right << std::fixed << std::setprecision(4)
+       << std::setw(10) << phase.perf.seconds << std::setw(10) << phase.objects << std::setw(14)
+       << counter(phase.perf.cycles) << std::setw(14) << counter(phase.perf.instructions) << std::setw(6) << ipc.str()
+       << std::setw(14) << per_object(phase.perf.llc_misses, phase.objects) << std::setw(12)
+       << per_object(phase.perf.page_faults, phase.objects) << "\n";
+  }
+}
@@ -0,0 +1,111 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file load_monitor.hpp
+ * @brief Instrumentation of the phases of load_platform().
+ *
+ * The loader wraps each phase in a LoadMonitor::Phase and calls advance() for
+ * every object it creates. Depending on the environment, the monitor then:
+ *   - PLATFORM_TRACE       reports per-phase time and hardware counters on stderr
+ *   - PLATFORM_PROGRESS    keeps a progress line (objects, rate, ETA) on stderr
+ *   - PLATFORM_MAX_SECONDS aborts the load when it takes longer than this
+ *   - PLATFORM_MAX_RSS     aborts the load when the process grows beyond this (e.g. 64G)
+ * and calls the callback installed with set_progress_callback(). When none of
+ * these is active, advance() is a counter increment and a comparison.
+ */
+
+#ifndef LOAD_MONITOR_HPP
+#define LOAD_MONITOR_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+#include "json_platform_loader.hpp"
+#include "perf_counters.hpp"
+
+class LoadMonitor {
+  using Clock = std::chrono::steady_clock;
+
+  struct PhaseStats {
+    std::string name;
+    PerfSample perf;
+    size_t objects = 0; // Hosts and links created, plus extra objects reported by the loader
+    size_t done    = 0; // Progress units (objects counted by advance())
+    size_t total   = 0;
+  };
+
+  const simgrid::s4u::Engine* e_ = nullptr;
+  std::unique_ptr<PerfCounters> counters_;
+  bool progress_line_      = false;
+  bool line_pending_       = false;
+  double max_seconds_      = 0.0;
+  size_t max_rss_          = 0;
+  ProgressCallback callback_;
+  double callback_interval_ = 1.0;
+  bool active_              = false;
+
+  std::map<std::string, size_t> totals_;
+  std::vector<PhaseStats> phases_;
+  PhaseStats* current_ = nullptr;
+  size_t done_         = 0;
+  size_t next_check_   = std::numeric_limits<size_t>::max();
+  Clock::time_point load_start_;
+  Clock::time_point segment_start_;
+  Clock::time_point last_line_;
+  Clock::time_point last_callback_;
+
+  size_t engine_objects() const { return e_->get_host_count() + e_->get_link_count(); }
+  PhaseStats& stats(const std::string& name);
+  LoadProgress snapshot(Clock::time_point now) const;
+  void check();
+  [[noreturn]] void abort(const std::string& reason, const LoadProgress& progress);
+
+public:
+  class Phase {
+    LoadMonitor* monitor_;
+    size_t start_objects_ = 0;
+    size_t extra_objects_ = 0;
+
+  public:
+    Phase(LoadMonitor* monitor, const std::string& name);
+    Phase(const Phase&)            = delete;
+    Phase& operator=(const Phase&) = delete;
+    ~Phase();
+    /** Count objects that are neither hosts nor links (e.g. partitions) in the trace */
+    void add_objects(size_t count) { extra_objects_ += count; }
+  };
+
+  /** Read the environment and reset the statistics; called at the beginning of load_platform() */
+  void start(const simgrid::s4u::Engine& e);
+  /** Number of objects each phase will create, for percentages and ETAs */
+  void set_totals(std::map<std::string, size_t> totals) { totals_ = std::move(totals); }
+  void set_callback(ProgressCallback callback, double interval);
+
+  Phase phase(const std::string& name) { return Phase(active_ ? this : nullptr, name); }
+
+  /** Record @p count more objects of the current phase */
+  void advance(size_t count = 1)
+  {
+    done_ += count;
+    if (done_ >= next_check_)
+      check();
+  }
+
+  /** Terminate the progress line and print the trace, if enabled */
+  void finish(std::ostream& os);
+};
+
+extern LoadMonitor load_monitor;
+
+#endif
@@ -0,0 +1,193 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "page_cache.hpp"
+
+namespace sg4 = simgrid::s4u;
+
+namespace {
+
+std::map<std::string, std::unique_ptr<PageCache>> caches;
+std::vector<PageCacheFactory> factories;
+
+void print_cache_stats()
+{
+  PageCache::Stats total;
+  for (const auto& [name, cache] : caches) {
+    const auto& stats = cache->get_stats();
+    if (stats.hits + stats.misses == 0)
+      continue;
+    std::cerr << "[platform] cache " << name << ": " << stats.hits << " hits, " << stats.misses << " misses ("
+              << std::fixed << std::setprecision(1) << 100 * stats.hit_rate() << "%), " << stats.hit_bytes
+              << " bytes from memory, " << stats.miss_bytes << " from disk, " << stats.evictions << " evictions\n";
+    total.hits += stats.hits;
+    total.misses += stats.misses;
+    total.hit_bytes += stats.hit_bytes;
+    total.miss_bytes += stats.miss_bytes;
+    total.evictions += stats.evictions;
+  }
+  std::cerr << "[platform] caches: " << total.hits << " hits, " << total.misses << " misses (" << std::fixed
+            << std::setprecision(1) << 100 * total.hit_rate() << "%), " << total.evictions << " evictions\n";
+}
+
+// Print the statistics at the end of the simulation when PLATFORM_CACHE_STATS is set, once
+void watch_cache_stats()
+{
+  static bool watched = false;
+  if (const char* env = std::getenv("PLATFORM_CACHE_STATS"); not watched && env && std::string(env) != "0")
+    sg4::Engine::on_simulation_end_cb(print_cache_stats);
+  watched = true;
+}
+
+} // namespace
+
+PageCache::PageCache(std::string name, const PageCacheConfig& config, sg4::Disk* memory, std::vector<sg4::Disk*> disks)
+    : name_(std::move(name))
+    , config_(config)
+    , capacity_(config.block_size == 0 ? 0 : config.size / config.block_size)
+    , memory_(memory)
+    , disks_(std::move(disks))
+{
+  if (config.block_size == 0 || disks_.empty())
+    throw std::runtime_error("Cache of " + name_ + " needs a positive block size and a storage with disks");
+}
+
+uint32_t PageCache::file_id(const std::string& path)
+{
+  return files_.try_emplace(path, static_cast<uint32_t>(files_.size())).first->second;
+}
+
+void PageCache::insert(const Block& block)
+{
+  if (capacity_ == 0)
+    return;
+  if (blocks_.size() >= capacity_) {
+    blocks_.erase(order_.front());
+    order_.pop_front();
+    stats_.evictions++;
+  }
+  order_.push_back(block);
+  blocks_.emplace(block, std::prev(order_.end()));
+}
+
+void PageCache::disk_io(sg_size_t bytes, bool write, std::vector<sg4::IoPtr>& ios) const
+{
+  // Spread over the disks, as JBOD storages stripe their data
+  const sg_size_t share = bytes / disks_.size();
+  for (size_t d = 0; d < disks_.size(); d++) {
+    const sg_size_t part = share + (d < bytes % disks_.size() ? 1 : 0);
+    if (part > 0)
+      ios.push_back(write ? disks_[d]->write_async(part) : disks_[d]->read_async(part));
+  }
+}
+
+void PageCache::read(const std::string& path, sg_size_t offset, sg_size_t size)
+{
+  if (size == 0)
+    return;
+  const uint32_t file  = file_id(path);
+  const sg_size_t bs   = config_.block_size;
+  sg_size_t hit_bytes  = 0;
+  sg_size_t miss_bytes = 0;
+  for (uint64_t index = offset / bs; index <= (offset + size - 1) / bs; index++) {
+    const sg_size_t overlap = std::min(offset + size, (index + 1) * bs) - std::max(offset, index * bs);
+    const Block block{file, index};
+    auto it = blocks_.find(block);
+    if (it != blocks_.end()) {
+      stats_.hits++;
+      hit_bytes += overlap;
+      if (config_.policy == PageCacheConfig::Policy::LRU)
+        order_.splice(order_.end(), order_, it->second);
+    } else {
+      stats_.misses++;
+      miss_bytes += overlap;
+      insert(block);
+    }
+  }
+  stats_.hit_bytes += hit_bytes;
+  stats_.miss_bytes += miss_bytes;
+
+  std::vector<sg4::IoPtr> ios;
+  if (hit_bytes > 0)
+    ios.push_back(memory_->read_async(hit_bytes));
+  disk_io(miss_bytes, false, ios);
+  for (auto& io : ios)
+    io->wait();
+}
+
+void PageCache::write(const std::string& path, sg_size_t offset, sg_size_t size)
+{
+  if (size == 0)
+    return;
+  const uint32_t file = file_id(path);
+  const sg_size_t bs  = config_.block_size;
+  for (uint64_t index = offset / bs; index <= (offset + size - 1) / bs; index++) {
+    const Block block{file, index};
+    auto it = blocks_.find(block);
+    if (it == blocks_.end())
+      insert(block);
+    else if (config_.policy == PageCacheConfig::Policy::LRU)
+      order_.splice(order_.end(), order_, it->second);
+  }
+
+  // Written to memory and through to the disks
+  std::vector<sg4::IoPtr> ios;
+  ios.push_back(memory_->write_async(size));
+  disk_io(size, true, ios);
+  for (auto& io : ios)
+    io->wait();
+}
+
+void PageCache::invalidate(const std::string& path)
+{
+  auto file = files_.find(path);
+  if (file == files_.end())
+    return;
+  for (auto it = order_.begin(); it != order_.end();) {
+    if (it->file == file->second) {
+      blocks_.erase(*it);
+      it = order_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+PageCache* page_cache(const std::string& storage_name)
+{
+  if (auto it = caches.find(storage_name); it != caches.end())
+    return it->second.get();
+  for (const auto& factory : factories)
+    if (auto cache = factory(storage_name))
+      return (caches[storage_name] = std::move(cache)).get();
+  return nullptr;
+}
+
+const std::map<std::string, std::unique_ptr<PageCache>>& page_caches()
+{
+  return caches;
+}
+
+PageCache* add_page_cache(const std::string& storage_name, const PageCacheConfig& config, sg4::Disk* memory,
+                          std::vector<sg4::Disk*> disks)
+{
+  watch_cache_stats();
+  auto& cache = caches[storage_name];
+  cache       = std::make_unique<PageCache>(storage_name, config, memory, std::move(disks));
+  return cache.get();
+}
+
+void add_page_cache_factory(PageCacheFactory factory)
+{
+  watch_cache_stats();
+  factories.push_back(std::move(factory));
+}
@@ -0,0 +1,128 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file page_cache.hpp
+ * @brief Page-cache model in front of the storages created by the loader.
+ *
+ * A storage system or a node-local storage with a "cache" block gets a
+ * PageCache: a memory of "size" bytes, managed in blocks of "block_size"
+ * bytes with an LRU or FIFO "policy", read and written at the memory
+ * "bandwidth". The memory is a SimGrid disk of the storage's host (named
+ * after the storage, with a "_cache" suffix), so that concurrent hits share
+ * its bandwidth as concurrent disk accesses do.
+ *
+ * FSMod storages only see sizes, not which file or offset is accessed, so
+ * the cache cannot sit inside them. Simulators call the cache of the storage
+ * holding a file instead of reading the file through FSMod:
+ *
+ *     PageCache* cache = page_cache(partition->get_storage()->get_name());
+ *     cache->read("/scratch/input.dat", 0, 512 * MiB); // Misses go to the storage's disks
+ *
+ * Writes go through to the disks and leave their blocks in the cache. Hits
+ * and misses are counted per cache, and PLATFORM_CACHE_STATS=1 prints them
+ * at the end of the simulation.
+ *
+ * Node storages may number in the hundred thousands, so their caches are made
+ * by a PageCacheFactory the first time page_cache() asks for them; only their
+ * memory disks, being part of the SimGrid platform, exist from load time.
+ */
+
+#ifndef PAGE_CACHE_HPP
+#define PAGE_CACHE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+/** Settings of a "cache" block, with units parsed */
+struct PageCacheConfig {
+  enum class Policy { LRU, FIFO };
+  sg_size_t size       = 0;       // Bytes
+  double bandwidth     = 0;       // Bytes per second
+  sg_size_t block_size = 1 << 20; // Bytes
+  Policy policy        = Policy::LRU;
+};
+
+class PageCache {
+public:
+  struct Stats {
+    size_t hits          = 0; // Blocks found in the cache by reads
+    size_t misses        = 0; // Blocks read from the disks
+    sg_size_t hit_bytes  = 0;
+    sg_size_t miss_bytes = 0;
+    size_t evictions     = 0;
+
+    double hit_rate() const { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses); }
+  };
+
+private:
+  struct Block {
+    uint32_t file;
+    uint64_t index;
+    bool operator==(const Block& other) const { return file == other.file && index == other.index; }
+  };
+  struct BlockHash {
+    size_t operator()(const Block& b) const { return std::hash<uint64_t>()(b.index * 0x9e3779b97f4a7c15ULL ^ b.file); }
+  };
+
+  std::string name_;
+  PageCacheConfig config_;
+  size_t capacity_; // Blocks
+  simgrid::s4u::Disk* memory_;
+  std::vector<simgrid::s4u::Disk*> disks_;
+  std::unordered_map<std::string, uint32_t> files_;
+  std::list<Block> order_; // Next victim first
+  std::unordered_map<Block, std::list<Block>::iterator, BlockHash> blocks_;
+  Stats stats_;
+
+  uint32_t file_id(const std::string& path);
+  void insert(const Block& block);
+  // Read or write @p bytes over the disks of the storage, in parallel
+  void disk_io(sg_size_t bytes, bool write, std::vector<simgrid::s4u::IoPtr>& ios) const;
+
+public:
+  /** Cache named @p name, read at the bandwidth of @p memory, in front of @p disks */
+  PageCache(std::string name, const PageCacheConfig& config, simgrid::s4u::Disk* memory,
+            std::vector<simgrid::s4u::Disk*> disks);
+
+  /** Read @p size bytes of @p path from @p offset: hits at memory speed, misses from the disks, concurrently */
+  void read(const std::string& path, sg_size_t offset, sg_size_t size);
+  /** Write @p size bytes of @p path from @p offset through to the disks, keeping the blocks in the cache */
+  void write(const std::string& path, sg_size_t offset, sg_size_t size);
+  /** Drop the blocks of @p path, e.g. when the file is deleted or rewritten elsewhere */
+  void invalidate(const std::string& path);
+
+  const std::string& get_name() const { return name_; }
+  const PageCacheConfig& get_config() const { return config_; }
+  const Stats& get_stats() const { return stats_; }
+  /** Bytes currently cached */
+  sg_size_t get_used() const { return blocks_.size() * config_.block_size; }
+};
+
+/** Cache in front of the storage named @p storage_name, created on first use for node storages, or nullptr */
+PageCache* page_cache(const std::string& storage_name);
+
+/** All the caches created so far, by storage name */
+const std::map<std::string, std::unique_ptr<PageCache>>& page_caches();
+
+/** Create the cache of the storage named @p storage_name; used by the loader */
+PageCache* add_page_cache(const std::string& storage_name, const PageCacheConfig& config,
+                          simgrid::s4u::Disk* memory, std::vector<simgrid::s4u::Disk*> disks);
+
+/** Cache of the storage named as given, or nullptr when the storage is not one of the factory's */
+using PageCacheFactory = std::function<std::unique_ptr<PageCache>(const std::string& storage_name)>;
+
+/** Have @p factory make caches the first time page_cache() asks for them; used by the loader */
+void add_page_cache_factory(PageCacheFactory factory);
+
+#endif
@@ -0,0 +1,128 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file perf_counters.hpp
+ * @brief Hardware performance counters of the calling thread (Linux perf_event_open).
+ *
+ * Cycles, instructions, last-level cache misses and page faults are opened as
+ * independent counters, so that whatever the kernel or the hardware allows is
+ * still measured. Counters that cannot be opened (e.g. perf_event_paranoid,
+ * containers, virtual machines) read as -1; page faults then fall back to
+ * getrusage(), and wall time is always available.
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+struct PerfSample {
+  double seconds         = 0.0;
+  long long cycles       = -1;
+  long long instructions = -1;
+  long long llc_misses   = -1;
+  long long page_faults  = -1;
+
+  double ipc() const { return (cycles > 0 && instructions >= 0) ? static_cast<double>(instructions) / cycles : -1.0; }
+
+  PerfSample& operator+=(const PerfSample& other)
+  {
+    seconds += other.seconds;
+    auto add = [](long long& total, long long value) { total = (total < 0 || value < 0) ? value : total + value; };
+    add(cycles, other.cycles);
+    add(instructions, other.instructions);
+    add(llc_misses, other.llc_misses);
+    add(page_faults, other.page_faults);
+    return *this;
+  }
+};
+
+class PerfCounters {
+  enum { CYCLES, INSTRUCTIONS, LLC_MISSES, PAGE_FAULTS, COUNT };
+  std::array<int, COUNT> fds_;
+  std::chrono::steady_clock::time_point start_time_;
+  long long start_rusage_faults_ = 0;
+
+  static int open_counter(uint32_t type, uint64_t config)
+  {
+    perf_event_attr attr{};
+    attr.type           = type;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  static long long rusage_faults()
+  {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+  }
+
+public:
+  PerfCounters()
+  {
+    fds_[CYCLES]       = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds_[INSTRUCTIONS] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds_[LLC_MISSES]   = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fds_[PAGE_FAULTS]  = open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+  }
+  PerfCounters(const PerfCounters&)            = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  ~PerfCounters()
+  {
+    for (int fd : fds_)
+      if (fd >= 0)
+        close(fd);
+  }
+
+  /** Whether at least one hardware counter could be opened */
+  bool available() const { return fds_[CYCLES] >= 0 || fds_[INSTRUCTIONS] >= 0 || fds_[LLC_MISSES] >= 0; }
+
+  void start()
+  {
+    start_rusage_faults_ = rusage_faults();
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+    start_time_ = std::chrono::steady_clock::now();
+  }
+
+  PerfSample stop()
+  {
+    PerfSample sample;
+    sample.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    std::array<long long, COUNT> values;
+    for (int i = 0; i < COUNT; i++) {
+      values[i] = -1;
+      if (fds_[i] >= 0) {
+        ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fds_[i], &values[i], sizeof(values[i])) != sizeof(values[i]))
+          values[i] = -1;
+      }
+    }
+    sample.cycles       = values[CYCLES];
+    sample.instructions = values[INSTRUCTIONS];
+    sample.llc_misses   = values[LLC_MISSES];
+    sample.page_faults  = (values[PAGE_FAULTS] >= 0) ? values[PAGE_FAULTS] : rusage_faults() - start_rusage_faults_;
+    return sample;
+  }
+};
+
+#endif
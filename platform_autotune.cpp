@@ -0,0 +1,486 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file platform_autotune.cpp
+ * @brief Pick the fastest encoding of a platform that simulates a workload identically.
+ *
+ * Several encodings of the same JSON configuration simulate our workloads
+ * with the same results at different speeds. This tool runs a short synthetic
+ * workload (see synthetic_workloads.hpp) on each variant:
+ *   - encoding : the JSON loader (explicit star routes), or SimGrid's <cluster>
+ *                tag with split-duplex or shared private links, with or without
+ *                the configured loopback
+ *   - routing  : the routing of every facility and nested zone, as configured
+ *                or forced to Full, Floyd or Dijkstra
+ *   - solver   : network/optim Lazy (SimGrid's default) or Full
+ * Variants run in parallel forked processes. A variant is kept if the end time
+ * of every actor matches the baseline (the configuration as is, with SimGrid's
+ * defaults) within a relative tolerance, and the kept variant with the lowest
+ * median load plus simulation time is written out: a JSON configuration for
+ * the loader, or a SimGrid XML platform with the solver settings in its
+ * <config> block. Solver settings of a JSON winner are printed as --cfg
+ * options, as they must be set before the platform is loaded.
+ *
+ * Usage: platform_autotune <config.json> -o <output> [--workload NAME] [--hosts N] [--size BYTES]
+ *                          [--runs N] [--jobs N] [--tolerance REL] [--lib libplatform.so]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <simgrid/s4u.hpp>
+
+#include "config_expander.hpp"
+#include "synthetic_workloads.hpp"
+#include "xml_exporter.hpp"
+
+namespace sg4 = simgrid::s4u;
+using json    = nlohmann::json;
+using Clock   = std::chrono::steady_clock;
+
+struct Variant {
+  std::string encoding; // "json", "xml", "xml-shared" or "xml-no-loopback"
+  std::string routing;  // Empty for the configured routing
+  std::string optim;    // Empty for SimGrid's default
+  std::string platform_file;
+  std::string json_config;
+
+  std::string label() const
+  {
+    return encoding + " " + (routing.empty() ? "as-configured" : routing) + " " + (optim.empty() ? "default" : optim);
+  }
+};
+
+// Fixed-size part of a run result; the end time of each actor follows it in the pipe
+struct RunHeader {
+  bool ok               = false;
+  bool applicable       = true;
+  double load_seconds   = 0.0;
+  double run_seconds    = 0.0;
+  double simulated_time = 0.0;
+  size_t events         = 0;
+  size_t actors         = 0;
+};
+
+struct RunResult {
+  RunHeader header;
+  std::vector<std::pair<std::string, double>> end_times;
+};
+
+struct VariantResult {
+  std::vector<RunResult> runs;
+  bool agrees    = false;
+  double seconds = 0.0; // Median load plus simulation time
+  std::string issue;    // Why the variant was not kept
+};
+
+struct Task {
+  size_t variant;
+  pid_t pid;
+  int fd;
+};
+
+// Child side: load the variant, run the workload and write the result to @p fd
+[[noreturn]] void run_child(const Variant& variant, const std::string& workload, size_t max_hosts, double size, int fd)
+{
+  if (not variant.json_config.empty())
+    setenv("PLATFORM_CONFIG", variant.json_config.c_str(), 1);
+
+  RunHeader header;
+  std::string names;
+  std::vector<double> times;
+  try {
+    std::vector<std::string> args = {"platform_autotune", "--log=root.thresh:critical"};
+    if (not variant.optim.empty())
+      args.push_back("--cfg=network/optim:" + variant.optim);
+    std::vector<char*> argv;
+    for (auto& arg : args)
+      argv.push_back(arg.data());
+    argv.push_back(nullptr);
+    int argc = static_cast<int>(args.size());
+    sg4::Engine e(&argc, argv.data());
+
+    auto start = Clock::now();
+    e.load_platform(variant.platform_file);
+    header.load_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    header.applicable   = deploy_workload(e, workload, max_hosts, size);
+    if (header.applicable) {
+      start = Clock::now();
+      e.run();
+      header.run_seconds    = std::chrono::duration<double>(Clock::now() - start).count();
+      header.simulated_time = sg4::Engine::get_clock();
+      header.events         = workload_stats.events;
+      for (const auto& [name, time] : workload_stats.end_times) {
+        names.append(name).push_back('\n');
+        times.push_back(time);
+      }
+      header.actors = times.size();
+    }
+    header.ok = true;
+  } catch (const std::exception& ex) {
+    std::cerr << "  " << variant.label() << " failed: " << ex.what() << "\n";
+  }
+
+  const size_t names_size = names.size();
+  const size_t times_size = times.size() * sizeof(double);
+  bool written = write(fd, &header, sizeof(header)) == sizeof(header) &&
+                 write(fd, &names_size, sizeof(names_size)) == sizeof(names_size) &&
+                 write(fd, names.data(), names_size) == static_cast<ssize_t>(names_size) &&
+                 write(fd, times.data(), times_size) == static_cast<ssize_t>(times_size);
+  _exit(written ? 0 : 2); // Skip the engine teardown, it is not part of the measurement
+}
+
+bool read_all(int fd, void* data, size_t size)
+{
+  auto* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, bytes, size);
+    if (n <= 0)
+      return false;
+    bytes += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Parent side: read the result of a finished or running child, then reap it
+RunResult collect(const Task& task)
+{
+  RunResult result;
+  size_t names_size = 0;
+  std::string names;
+  std::vector<double> times;
+  bool complete = read_all(task.fd, &result.header, sizeof(result.header)) &&
+                  read_all(task.fd, &names_size, sizeof(names_size));
+  if (complete) {
+    names.resize(names_size);
+    times.resize(result.header.actors);
+    complete = read_all(task.fd, names.data(), names_size) &&
+               read_all(task.fd, times.data(), times.size() * sizeof(double));
+  }
+  close(task.fd);
+  int status;
+  waitpid(task.pid, &status, 0);
+  if (not complete || not WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    result.header.ok = false;
+    return result;
+  }
+
+  size_t begin = 0;
+  for (double time : times) {
+    size_t end = names.find('\n', begin);
+    result.end_times.emplace_back(names.substr(begin, end - begin), time);
+    begin = end + 1;
+  }
+  return result;
+}
+
+// Run every variant @p runs times, with at most @p jobs children at once
+std::vector<VariantResult> run_variants(const std::vector<Variant>& variants, const std::string& workload,
+                                        size_t max_hosts, double size, int runs, int jobs)
+{
+  std::vector<VariantResult> results(variants.size());
+  std::deque<Task> running;
+  for (int run = 0; run < runs; run++) {
+    for (size_t v = 0; v < variants.size(); v++) {
+      if (static_cast<int>(running.size()) >= jobs) {
+        results[running.front().variant].runs.push_back(collect(running.front()));
+        running.pop_front();
+      }
+      int fds[2];
+      if (pipe(fds) != 0)
+        throw std::runtime_error("Cannot create a pipe");
+      std::cout.flush();
+      pid_t pid = fork();
+      if (pid == 0) {
+        close(fds[0]);
+        run_child(variants[v], workload, max_hosts, size, fds[1]);
+      }
+      close(fds[1]);
+      if (pid < 0) {
+        close(fds[0]);
+        throw std::runtime_error("Cannot fork");
+      }
+      running.push_back({v, pid, fds[0]});
+    }
+  }
+  for (const auto& task : running)
+    results[task.variant].runs.push_back(collect(task));
+  return results;
+}
+
+// First difference between the end times of @p run and @p baseline, empty if they agree within @p tolerance
+std::string compare_runs(const RunResult& run, const RunResult& baseline, double tolerance)
+{
+  if (run.end_times.size() != baseline.end_times.size())
+    return std::to_string(run.end_times.size()) + " actors finished instead of " +
+           std::to_string(baseline.end_times.size());
+  for (size_t i = 0; i < run.end_times.size(); i++) {
+    const auto& [name, time]         = run.end_times[i];
+    const auto& [ref_name, ref_time] = baseline.end_times[i];
+    if (name != ref_name)
+      return "actor " + ref_name + " did not finish";
+    if (std::abs(time - ref_time) > tolerance * std::max(std::abs(ref_time), 1e-9)) {
+      std::ostringstream oss;
+      oss << "actor " << name << " ends at " << time << " s instead of " << ref_time << " s";
+      return oss.str();
+    }
+  }
+  return "";
+}
+
+// Force the routing of every facility and nested zone
+void set_routing(json& zones_config, const std::string& routing)
+{
+  for (auto& zone_config : zones_config) {
+    zone_config["routing"] = routing;
+    if (zone_config.contains("zones"))
+      set_routing(zone_config["zones"], routing);
+  }
+}
+
+// Make the relative paths of the configuration usable from another directory
+void absolute_paths(json& zones_config, const std::filesystem::path& config_dir)
+{
+  for (auto& zone_config : zones_config) {
+    if (zone_config.contains("graphs"))
+      for (auto& graph_cfg : zone_config["graphs"])
+        for (const char* key : {"nodes", "edges"})
+          graph_cfg[key] = std::filesystem::absolute(config_dir / graph_cfg[key].get<std::string>()).string();
+    if (zone_config.contains("zones"))
+      absolute_paths(zone_config["zones"], config_dir);
+  }
+}
+
+XmlExportOptions xml_options(const Variant& variant)
+{
+  XmlExportOptions options;
+  options.split_duplex = variant.encoding != "xml-shared";
+  options.loopback     = variant.encoding != "xml-no-loopback";
+  if (not variant.optim.empty())
+    options.config["network/optim"] = variant.optim;
+  return options;
+}
+
+json variant_config(const json& config, const Variant& variant)
+{
+  json result = config;
+  if (not variant.routing.empty())
+    set_routing(result["facilities"], variant.routing);
+  return result;
+}
+
+std::string default_library_path()
+{
+  char exe[4096];
+  ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  if (len <= 0)
+    return "libplatform.so";
+  exe[len] = '\0';
+  std::string dir(exe);
+  return dir.substr(0, dir.rfind('/') + 1) + "libplatform.so";
+}
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " <config.json> -o <output> [options]\n\n"
+            << "Run a workload on equivalent encodings of a platform and write the fastest one that gives the same\n"
+            << "results: a JSON configuration, or a SimGrid XML platform (.xml) if an XML encoding wins.\n\n"
+            << "Options:\n"
+            << "  -o output        Optimized configuration to write\n"
+            << "  --workload NAME  all-to-all, scatter-pfs or local-io (default: all-to-all)\n"
+            << "  --hosts N        Compute hosts taking part in the workload (default: 32)\n"
+            << "  --size BYTES     Size of each message and I/O (default: 1e8)\n"
+            << "  --runs N         Runs per variant (default: 3)\n"
+            << "  --jobs N         Variants run at once (default: number of cores)\n"
+            << "  --tolerance REL  Relative tolerance on actor end times (default: 1e-6)\n"
+            << "  --lib path       JSON loader library (default: libplatform.so next to this tool)\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::string config_path = argv[1];
+  if (config_path == "-h" || config_path == "--help") {
+    print_usage(argv[0]);
+    return 0;
+  }
+
+  std::string output_path;
+  std::string workload = "all-to-all";
+  size_t max_hosts     = 32;
+  double size          = 1e8;
+  int runs             = 3;
+  int jobs             = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+  double tolerance     = 1e-6;
+  std::string lib_path = default_library_path();
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output_path = argv[++i];
+    } else if (strcmp(argv[i], "--workload") == 0 && i + 1 < argc) {
+      workload = argv[++i];
+    } else if (strcmp(argv[i], "--hosts") == 0 && i + 1 < argc) {
+      max_hosts = std::stoul(argv[++i]);
+    } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+      size = std::stod(argv[++i]);
+    } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      runs = std::stoi(argv[++i]);
+    } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+      jobs = std::stoi(argv[++i]);
+    } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+      tolerance = std::stod(argv[++i]);
+    } else if (strcmp(argv[i], "--lib") == 0 && i + 1 < argc) {
+      lib_path = argv[++i];
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+  if (output_path.empty() || runs <= 0 || jobs <= 0 ||
+      std::find(synthetic_workloads.begin(), synthetic_workloads.end(), workload) == synthetic_workloads.end()) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    std::cerr << "Cannot open config file: " << config_path << "\n";
+    return 1;
+  }
+  json config = expand_config(json::parse(config_file));
+  absolute_paths(config["facilities"], std::filesystem::path(config_path).parent_path());
+  // Side outputs of the loader are not wanted while tuning
+  json tuning_config = config;
+  tuning_config.erase("name_map");
+  tuning_config.erase("topology_index");
+
+  // The baseline comes first
+  std::vector<Variant> variants;
+  for (const char* encoding : {"json", "xml", "xml-shared", "xml-no-loopback"})
+    for (const char* routing : {"", "Full", "Floyd", "Dijkstra"})
+      for (const char* optim : {"", "Full"})
+        variants.push_back({encoding, routing, optim, "", ""});
+
+  const std::string tmp_base = "/tmp/platform_autotune_" + std::to_string(getpid());
+  std::vector<std::string> tmp_files;
+  for (size_t v = 0; v < variants.size(); v++) {
+    auto& variant    = variants[v];
+    json platform    = variant_config(tuning_config, variant);
+    std::string path = tmp_base + "_" + std::to_string(v);
+    if (variant.encoding == "json") {
+      variant.platform_file = lib_path;
+      variant.json_config   = path + ".json";
+      std::ofstream(variant.json_config) << platform.dump();
+      tmp_files.push_back(variant.json_config);
+      continue;
+    }
+    // Solver settings go through --cfg, the <config> block is only used in the output
+    XmlExportOptions options = xml_options(variant);
+    options.config.clear();
+    std::ostringstream xml;
+    try {
+      export_xml_platform(xml, platform, options);
+    } catch (const std::exception& ex) {
+      std::cerr << variant.label() << " skipped: " << ex.what() << "\n";
+      continue;
+    }
+    variant.platform_file = path + ".xml";
+    std::ofstream(variant.platform_file) << xml.str();
+    tmp_files.push_back(variant.platform_file);
+  }
+  variants.erase(std::remove_if(variants.begin(), variants.end(),
+                                [](const Variant& variant) { return variant.platform_file.empty(); }),
+                 variants.end());
+
+  std::cout << "\n=== PLATFORM AUTOTUNE: " << config_path << " (" << workload << ", up to " << max_hosts << " hosts, "
+            << variants.size() << " variants x " << runs << " runs, " << jobs << " jobs) ===\n\n";
+  std::vector<VariantResult> results = run_variants(variants, workload, max_hosts, size, runs, jobs);
+
+  for (auto& result : results) {
+    result.runs.erase(std::remove_if(result.runs.begin(), result.runs.end(),
+                                     [](const RunResult& r) { return not r.header.ok || not r.header.applicable; }),
+                      result.runs.end());
+    if (result.runs.empty())
+      continue;
+    std::vector<double> seconds;
+    for (const auto& run : result.runs)
+      seconds.push_back(run.header.load_seconds + run.header.run_seconds);
+    std::sort(seconds.begin(), seconds.end());
+    result.seconds = seconds[seconds.size() / 2];
+  }
+  for (const auto& file : tmp_files)
+    unlink(file.c_str());
+
+  if (results[0].runs.empty()) {
+    std::cerr << "The workload cannot run on " << config_path << " as configured\n";
+    return 1;
+  }
+  const RunResult& baseline = results[0].runs.front();
+
+  size_t best = 0;
+  std::cout << std::left << std::setw(36) << "variant" << std::right << std::setw(12) << "time (s)" << std::setw(10)
+            << "speedup"
+            << "  result\n";
+  for (size_t v = 0; v < variants.size(); v++) {
+    auto& result = results[v];
+    if (result.runs.empty()) {
+      result.issue = "failed or not applicable";
+    } else {
+      for (const auto& run : result.runs) {
+        result.issue = compare_runs(run, baseline, tolerance);
+        if (not result.issue.empty())
+          break;
+      }
+    }
+    result.agrees = result.issue.empty();
+    if (result.agrees && result.seconds < results[best].seconds)
+      best = v;
+
+    std::cout << std::left << std::setw(36) << variants[v].label() << std::right;
+    if (result.runs.empty())
+      std::cout << std::setw(12) << "-" << std::setw(10) << "-";
+    else
+      std::cout << std::fixed << std::setprecision(3) << std::setw(12) << result.seconds << std::setprecision(2)
+                << std::setw(9) << results[0].seconds / result.seconds << "x" << std::defaultfloat;
+    std::cout << "  " << (result.agrees ? "same" : result.issue) << "\n";
+  }
+
+  const Variant& winner = variants[best];
+  json optimized        = variant_config(config, winner);
+  if (winner.encoding == "json") {
+    std::ofstream(output_path) << optimized.dump(2) << "\n";
+  } else {
+    if (std::filesystem::path(output_path).extension() != ".xml")
+      output_path = std::filesystem::path(output_path).replace_extension(".xml").string();
+    std::ofstream xml_file(output_path);
+    export_xml_platform(xml_file, optimized, xml_options(winner));
+  }
+  std::cout << "\nFastest equivalent variant: " << winner.label() << " (" << std::setprecision(3)
+            << results[0].seconds / results[best].seconds << "x), written to " << output_path << "\n";
+  if (winner.encoding == "json" && not winner.optim.empty())
+    std::cout << "Run simulations with --cfg=network/optim:" << winner.optim << "\n";
+  std::cout << "\n";
+  return 0;
+}
@@ -0,0 +1,241 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file platform_bench.cpp
+ * @brief Load-time benchmark of the same platform through several loaders.
+ *
+ * This tool takes a JSON platform configuration and builds the corresponding
+ * platform through each available path:
+ *   - json : libplatform.so reading the configuration at load time
+ *   - cpp  : a platform library generated by platform_codegen (--cpp)
+ *   - xml  : the equivalent SimGrid XML file, read by SimGrid's native parser
+ *
+ * Each load runs in a forked process, so that every run starts from a fresh
+ * SimGrid engine. The tool reports the wall time and hardware counters (see
+ * perf_counters.hpp) of the load itself, and the peak RSS of the process, over
+ * repeated runs.
+ *
+ * Usage: platform_bench <config.json> [--runs N] [--lib libplatform.so]
+ *                       [--cpp libgenerated.so] [--emit-xml platform.xml]
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <simgrid/s4u.hpp>
+
+#include "config_expander.hpp"
+#include "perf_counters.hpp"
+#include "xml_exporter.hpp"
+
+namespace sg4 = simgrid::s4u;
+using json    = nlohmann::json;
+
+struct RunResult {
+  bool ok         = false;
+  PerfSample perf;
+  size_t hosts    = 0;
+  size_t links    = 0;
+  long max_rss_kb = 0;
+};
+
+// Load the platform in a forked child and collect its measurements
+RunResult run_once(const std::string& platform_file, const std::string& json_config)
+{
+  RunResult result;
+  int fds[2];
+  if (pipe(fds) != 0)
+    return result;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    if (not json_config.empty())
+      setenv("PLATFORM_CONFIG", json_config.c_str(), 1);
+
+    RunResult child;
+    try {
+      std::string prog = "platform_bench";
+      std::string log  = "--log=root.thresh:critical";
+      int argc         = 2;
+      char* argv[]     = {prog.data(), log.data(), nullptr};
+      sg4::Engine e(&argc, argv);
+
+      PerfCounters counters;
+      counters.start();
+      e.load_platform(platform_file);
+      child.perf  = counters.stop();
+      child.hosts = e.get_host_count();
+      child.links = e.get_link_count();
+      child.ok    = true;
+    } catch (const std::exception& ex) {
+      std::cerr << "  load of " << platform_file << " failed: " << ex.what() << "\n";
+    }
+    if (write(fds[1], &child, sizeof(child)) != sizeof(child))
+      _exit(2);
+    _exit(0); // Skip the engine teardown, it is not part of the measurement
+  }
+
+  close(fds[1]);
+  if (pid > 0) {
+    if (read(fds[0], &result, sizeof(result)) != sizeof(result))
+      result.ok = false;
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    result.max_rss_kb = usage.ru_maxrss;
+    if (not WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      result.ok = false;
+  }
+  close(fds[0]);
+  return result;
+}
+
+void report(const std::string& label, std::vector<RunResult>& runs)
+{
+  runs.erase(std::remove_if(runs.begin(), runs.end(), [](const RunResult& r) { return not r.ok; }), runs.end());
+  std::cout << std::left << std::setw(6) << label << std::right;
+  if (runs.empty()) {
+    std::cout << "  failed\n";
+    return;
+  }
+
+  std::sort(runs.begin(), runs.end(),
+            [](const RunResult& a, const RunResult& b) { return a.perf.seconds < b.perf.seconds; });
+  const auto& median = runs[runs.size() / 2];
+  long max_rss       = 0;
+  for (const auto& r : runs)
+    max_rss = std::max(max_rss, r.max_rss_kb);
+
+  // Unavailable counters read as -1
+  auto counter = [](long long value) { return value >= 0 ? std::to_string(value) : std::string("n/a"); };
+  std::ostringstream ipc;
+  if (median.perf.ipc() >= 0)
+    ipc << std::fixed << std::setprecision(2) << median.perf.ipc();
+  else
+    ipc << "n/a";
+
+  std::cout << std::fixed << std::setprecision(4) << std::setw(11) << runs.front().perf.seconds << std::setw(11)
+            << median.perf.seconds << std::setw(16) << counter(median.perf.instructions) << std::setw(6) << ipc.str()
+            << std::setw(12) << counter(median.perf.llc_misses) << std::setw(10) << counter(median.perf.page_faults)
+            << std::setw(12) << max_rss / 1024.0 << std::setw(9) << median.hosts << std::setw(9) << median.links
+            << std::setw(6) << runs.size() << "\n";
+}
+
+std::string default_library_path()
+{
+  char exe[4096];
+  ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  if (len <= 0)
+    return "libplatform.so";
+  exe[len] = '\0';
+  std::string dir(exe);
+  return dir.substr(0, dir.rfind('/') + 1) + "libplatform.so";
+}
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " <config.json> [options]\n\n"
+            << "Compare the load time of a platform through the JSON loader, a generated C++ loader and XML.\n\n"
+            << "Options:\n"
+            << "  --runs N             Number of forked runs per loader (default: 5)\n"
+            << "  --lib path           JSON loader library (default: libplatform.so next to this tool)\n"
+            << "  --cpp path           Library generated from the same config by platform_codegen\n"
+            << "  --emit-xml path      Where to write the equivalent SimGrid XML (default: temporary file)\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::string config_path = argv[1];
+  if (config_path == "-h" || config_path == "--help") {
+    print_usage(argv[0]);
+    return 0;
+  }
+
+  int runs = 5;
+  std::string lib_path = default_library_path();
+  std::string cpp_path;
+  std::string xml_path;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      runs = std::stoi(argv[++i]);
+    } else if (strcmp(argv[i], "--lib") == 0 && i + 1 < argc) {
+      lib_path = argv[++i];
+    } else if (strcmp(argv[i], "--cpp") == 0 && i + 1 < argc) {
+      cpp_path = argv[++i];
+    } else if (strcmp(argv[i], "--emit-xml") == 0 && i + 1 < argc) {
+      xml_path = argv[++i];
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    std::cerr << "Cannot open config file: " << config_path << "\n";
+    return 1;
+  }
+  json config = expand_config(json::parse(config_file));
+
+  // Export the equivalent XML, kept on disk so that the native-parser numbers can be reproduced
+  bool keep_xml = not xml_path.empty();
+  if (not keep_xml)
+    xml_path = "/tmp/platform_bench_" + std::to_string(getpid()) + ".xml";
+  try {
+    std::ofstream xml_file(xml_path);
+    export_xml_platform(xml_file, config);
+  } catch (const std::exception& ex) {
+    std::cerr << "XML export skipped: " << ex.what() << "\n";
+    xml_path.clear();
+  }
+  if (keep_xml && not xml_path.empty())
+    std::cout << "Equivalent SimGrid XML written to " << xml_path << "\n";
+
+  std::cout << "\n=== LOAD BENCHMARK: " << config_path << " (" << runs << " runs) ===\n\n"
+            << std::left << std::setw(6) << "loader" << std::right << std::setw(11) << "min (s)" << std::setw(11)
+            << "med (s)" << std::setw(16) << "instructions" << std::setw(6) << "IPC" << std::setw(12) << "LLC misses"
+            << std::setw(10) << "faults" << std::setw(12) << "peak RSS MB" << std::setw(9)
+            << "hosts" << std::setw(9) << "links" << std::setw(6) << "runs"
+            << "\n";
+
+  std::vector<std::pair<std::string, std::pair<std::string, std::string>>> paths = {
+      {"json", {lib_path, std::filesystem::absolute(config_path).string()}}};
+  if (not cpp_path.empty())
+    paths.push_back({"cpp", {cpp_path, ""}});
+  if (not xml_path.empty())
+    paths.push_back({"xml", {xml_path, ""}});
+
+  for (const auto& [label, target] : paths) {
+    std::vector<RunResult> results;
+    for (int i = 0; i < runs; i++)
+      results.push_back(run_once(target.first, target.second));
+    report(label, results);
+  }
+  std::cout << "\n";
+
+  if (not keep_xml && not xml_path.empty())
+    unlink(xml_path.c_str());
+  return 0;
+}
@@ -0,0 +1,78 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file platform_check.cpp
+ * @brief Utility to validate the routes of a JSON platform configuration.
+ *
+ * This tool reads a JSON platform configuration and checks, without building
+ * the SimGrid platform, that every pair of leaf zones (clusters, storage
+ * systems, facilities and nested zones without sub-zones) has a route, and
+ * that no route goes through a zone lacking a gateway.
+ *
+ * Usage: platform_check <config.json> [--threads N] [--max-issues N]
+ *
+ * Exit status is 0 when all pairs are routable, 1 otherwise.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "config_expander.hpp"
+#include "route_checker.hpp"
+
+using json = nlohmann::json;
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " <config.json> [--threads N] [--max-issues N]\n\n"
+            << "Check that every pair of leaf zones of a JSON platform configuration is routable.\n\n"
+            << "Options:\n"
+            << "  --threads N     Number of worker threads (default: one per hardware thread)\n"
+            << "  --max-issues N  Maximum number of issues to display (default: 50)\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::string config_path = argv[1];
+  if (config_path == "-h" || config_path == "--help") {
+    print_usage(argv[0]);
+    return 0;
+  }
+
+  unsigned threads  = 0;
+  size_t max_issues = 50;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = std::stoul(argv[++i]);
+    } else if (strcmp(argv[i], "--max-issues") == 0 && i + 1 < argc) {
+      max_issues = std::stoul(argv[++i]);
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    std::cerr << "Cannot open config file: " << config_path << "\n";
+    return 1;
+  }
+  json config = expand_config(json::parse(config_file));
+
+  RouteCheckReport report = check_routes(config, threads);
+  report.print(std::cout, max_issues);
+
+  return report.ok() ? 0 : 1;
+}
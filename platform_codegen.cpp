@@ -0,0 +1,500 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file platform_codegen.cpp
+ * @brief Ahead-of-time compiler from a JSON platform configuration to C++.
+ *
+ * This tool reads a JSON platform configuration and writes a C++ translation
+ * unit that builds exactly the same platform as libplatform.so, without any
+ * parsing at load time: cluster loops have constant bounds, all bandwidths,
+ * latencies, speeds and sizes are converted to numbers at generation time, and
+ * host names are assembled from constant prefixes and suffixes.
+ *
+ * Usage: platform_codegen <config.json> [-o output.cpp] [--symbol name]
+ *
+ * The generated function is `extern "C" void <name>(const sg4::Engine&)`,
+ * `load_platform` by default, so that the compiled file can be used as a
+ * platform library. See cmake/PlatformCodegen.cmake for the CMake helpers.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <xbt/parse_units.hpp>
+
+#include "config_expander.hpp"
+#include "interconnect.hpp"
+#include "property_sets.hpp"
+
+using json = nlohmann::json;
+
+class CodeGenerator {
+  std::string config_path_;
+  std::ostringstream out_;
+  std::map<std::string, std::string> zone_vars_;         // zone name -> C++ variable
+  std::map<std::string, std::string> link_vars_;         // inter-zone link name -> C++ variable
+  std::map<std::string, std::string> storage_vars_;      // storage system name -> C++ variable
+  std::map<std::string, std::string> node_storage_vars_; // cluster name -> vector of node storages
+  int next_var_       = 0;
+  int next_cluster_   = 0;
+  bool compact_names_ = false; // "naming": "compact", see node_resource_name() in json_platform_loader.cpp
+
+  std::string new_var(const std::string& kind) { return kind + std::to_string(next_var_++); }
+
+  static std::string quote(const std::string& s) { return json(s).dump(); }
+
+  static std::string number(double value)
+  {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.17g", value);
+    std::string literal = buf;
+    if (literal.find_first_of(".en") == std::string::npos)
+      literal += ".0";
+    return literal;
+  }
+
+  // Numeric conversions are done here, once, with SimGrid's own unit parser
+  std::string speed(const std::string& s) const { return number(xbt_parse_get_speed(config_path_, 0, s, "speed")); }
+  std::string bandwidth(const std::string& s) const
+  {
+    return number(xbt_parse_get_bandwidth(config_path_, 0, s, "bandwidth"));
+  }
+  std::string latency(const std::string& s) const { return number(xbt_parse_get_time(config_path_, 0, s, "latency")); }
+  std::string size(const std::string& s) const
+  {
+    return "static_cast<sg_size_t>(" + number(xbt_parse_get_size(config_path_, 0, s, "size")) + ")";
+  }
+
+  // C++ expression of the name of a per-node resource, hostname being the readable base name
+  std::string node_name(int cluster, const std::string& readable_suffix, char tag) const
+  {
+    if (compact_names_)
+      return "indexed_name(" + quote("~" + std::to_string(cluster) + ".") + ", i, " + quote(std::string(1, tag)) + ")";
+    return "hostname + " + quote(readable_suffix);
+  }
+
+  static void unsupported(const json& cfg, const char* key, const std::string& where)
+  {
+    if (cfg.contains(key))
+      throw std::runtime_error("'" + std::string(key) + "' in " + where + " is not supported by platform_codegen");
+  }
+
+  void emit_storage_system(const std::string& parent, const json& storage_config)
+  {
+    const std::string name = storage_config["name"];
+    unsupported(storage_config, "cache", "storage system " + name);
+    const std::string zone = new_var("zone");
+    const std::string var  = new_var("storage");
+    zone_vars_[name]       = zone;
+    storage_vars_[name]    = var;
+
+    const std::string read_bw  = bandwidth(storage_config["read_bandwidth"]);
+    const std::string write_bw = bandwidth(storage_config["write_bandwidth"]);
+    const std::string type     = storage_config["type"];
+    int disk_count             = storage_config["disk_count"];
+
+    out_ << "  // Storage system " << name << "\n"
+         << "  auto* " << zone << " = " << parent << "->add_netzone_full(" << quote(name) << ");\n"
+         << "  [[maybe_unused]] std::shared_ptr<sgfs::Storage> " << var << ";\n"
+         << "  {\n"
+         << "    auto* server = " << zone << "->add_host(" << quote(name + "_server") << ", "
+         << speed(storage_config["server_speed"]) << ");\n";
+    if (type == "JBOD") {
+      out_ << "    std::vector<sg4::Disk*> disks;\n";
+      for (int i = 0; i < disk_count; i++) {
+        std::string disk_name = (disk_count == 1) ? name + "_disk" : name + "_disk" + std::to_string(i);
+        out_ << "    disks.push_back(server->add_disk(" << quote(disk_name) << ", " << read_bw << ", " << write_bw
+             << "));\n";
+      }
+      out_ << "    " << var << " = sgfs::JBODStorage::create(" << quote(name + "_storage") << ", disks);\n";
+    } else if (type == "OneDisk") {
+      out_ << "    auto* disk = server->add_disk(" << quote(name + "_disk") << ", " << read_bw << ", " << write_bw
+           << ");\n"
+           << "    " << var << " = sgfs::OneDiskStorage::create(" << quote(name + "_storage") << ", disk);\n";
+    }
+    out_ << "    " << zone << "->set_gateway(" << zone << "->add_router(" << quote(name + "_router") << "));\n"
+         << "    " << zone << "->seal();\n"
+         << "  }\n\n";
+  }
+
+  void emit_cluster(const std::string& parent, const json& cluster_config)
+  {
+    const std::string name   = cluster_config["name"];
+    const std::string prefix = cluster_config["prefix"];
+    const std::string suffix = cluster_config["suffix"];
+    int count                = cluster_config["count"];
+    const std::string zone   = new_var("zone");
+    zone_vars_[name]         = zone;
+    const int ordinal        = next_cluster_++;
+    unsupported(cluster_config, "vm_pools", "cluster " + name);
+    if (cluster_config.value("rails", 1) > 1)
+      throw std::runtime_error("'rails' in cluster " + name + " is not supported by platform_codegen");
+    if (cluster_config["node"].contains("storage"))
+      unsupported(cluster_config["node"]["storage"], "cache", "node storage of cluster " + name);
+
+    const auto& backbone_cfg     = cluster_config["backbone"];
+    const auto& node_cfg         = cluster_config["node"];
+    const auto& private_link_cfg = node_cfg["private_link"];
+    const auto& loopback_cfg     = node_cfg["loopback"];
+    const std::string link_bw    = bandwidth(private_link_cfg["bandwidth"]);
+    const std::string link_lat   = latency(private_link_cfg.value("latency", "0s"));
+
+    out_ << "  // Cluster " << name << "\n"
+         << "  auto* " << zone << " = " << parent << "->add_netzone_star(" << quote(name) << ");\n";
+    std::string storages;
+    if (node_cfg.contains("storage")) {
+      storages                = new_var("node_storages");
+      node_storage_vars_[name] = storages;
+      out_ << "  [[maybe_unused]] std::vector<std::shared_ptr<sgfs::Storage>> " << storages << ";\n"
+           << "  " << storages << ".reserve(" << count << ");\n";
+    }
+    // Distinct property sets and the node segments using them, resolved now
+    const ClusterProperties properties = resolve_cluster_properties(cluster_config);
+    std::string property_sets;
+    std::string property_segments;
+    if (not properties.empty()) {
+      property_sets     = new_var("properties");
+      property_segments = new_var("property_segments");
+      out_ << "  static const std::unordered_map<std::string, std::string> " << property_sets << "[] = {\n";
+      for (const auto& set : properties.sets) {
+        out_ << "      {";
+        for (const auto& [key, value] : set)
+          out_ << "{" << quote(key) << ", " << quote(value) << "}, ";
+        out_ << "},\n";
+      }
+      out_ << "  };\n"
+           << "  static const int " << property_segments << "[][3] = {";
+      for (const auto& segment : properties.segments)
+        out_ << "{" << segment.first << ", " << segment.last << ", " << segment.set << "}, ";
+      out_ << "};\n";
+    }
+    out_ << "  {\n"
+         << "    const auto* backbone = " << zone << "->add_link(" << quote(name + "_backbone") << ", "
+         << bandwidth(backbone_cfg["bandwidth"]) << ")->set_latency(" << latency(backbone_cfg.value("latency", "0s"))
+         << ");\n"
+         << (properties.empty() ? "" : "    size_t segment = 0;\n")
+         << "    for (int i = 0; i < " << count << "; i++) {\n"
+         << "      const std::string hostname = indexed_name(" << quote(prefix) << ", i, " << quote(suffix) << ");\n"
+         << "      auto* host = " << zone << "->add_host(hostname, " << speed(node_cfg["speed"]) << ")->set_core_count("
+         << node_cfg["cores"].get<int>() << ");\n";
+    if (not properties.empty()) {
+      out_ << "      while (segment < " << properties.segments.size() << " && " << property_segments
+           << "[segment][1] < i)\n"
+           << "        segment++;\n"
+           << "      if (segment < " << properties.segments.size() << " && " << property_segments
+           << "[segment][0] <= i)\n"
+           << "        host->set_properties(" << property_sets << "[" << property_segments << "[segment][2]]);\n";
+    }
+    if (not storages.empty()) {
+      const auto& storage_cfg       = node_cfg["storage"];
+      const std::string storage_sfx = "_" + storage_cfg["name"].get<std::string>();
+      out_ << "      auto* disk = host->add_disk(" << node_name(ordinal, storage_sfx + "_disk", 'k') << ", "
+           << bandwidth(storage_cfg["read_bandwidth"]) << ", " << bandwidth(storage_cfg["write_bandwidth"]) << ");\n"
+           << "      " << storages << ".push_back(sgfs::OneDiskStorage::create("
+           << node_name(ordinal, storage_sfx, 's') << ", disk));\n";
+    }
+    out_ << "      auto* link_up = " << zone << "->add_link(" << node_name(ordinal, "_LinkUP", 'u') << ", " << link_bw
+         << ")->set_latency(" << link_lat << ");\n"
+         << "      auto* link_down = " << zone << "->add_link(" << node_name(ordinal, "_LinkDOWN", 'd') << ", "
+         << link_bw << ")->set_latency(" << link_lat << ");\n"
+         << "      auto* loopback = " << zone << "->add_link(" << node_name(ordinal, "_loopback", 'l') << ", "
+         << bandwidth(loopback_cfg["bandwidth"]) << ")\n"
+         << "                           ->set_latency(" << latency(loopback_cfg.value("latency", "0s")) << ")\n"
+         << "                           ->set_sharing_policy(sg4::Link::SharingPolicy::FATPIPE);\n"
+         << "      " << zone
+         << "->add_route(host, nullptr, {sg4::LinkInRoute(link_up), sg4::LinkInRoute(backbone)}, false);\n"
+         << "      " << zone
+         << "->add_route(nullptr, host, {sg4::LinkInRoute(backbone), sg4::LinkInRoute(link_down)}, false);\n"
+         << "      " << zone << "->add_route(host, host, {loopback});\n"
+         << "    }\n"
+         << "    " << zone << "->set_gateway(" << zone << "->add_router(" << quote(name + "_router") << "));\n"
+         << "    " << zone << "->seal();\n"
+         << "  }\n\n";
+  }
+
+  void emit_links(const std::string& parent, const json& links_config)
+  {
+    for (const auto& link_cfg : links_config) {
+      const std::string link_name = link_cfg["name"];
+      const std::string var       = new_var("link");
+      link_vars_[link_name]       = var;
+      out_ << "  [[maybe_unused]] const auto* " << var << " = " << parent << "->add_link(" << quote(link_name) << ", "
+           << bandwidth(link_cfg["bandwidth"]) << ")->set_latency(" << latency(link_cfg.value("latency", "0s"))
+           << ");\n";
+    }
+  }
+
+  const std::string& lookup(const std::map<std::string, std::string>& vars, const std::string& name,
+                            const char* kind) const
+  {
+    auto it = vars.find(name);
+    if (it == vars.end())
+      throw std::runtime_error(std::string("Unknown ") + kind + " '" + name + "' in " + config_path_);
+    return it->second;
+  }
+
+  // Bandwidth and latency of a facility link, for the interconnect routes
+  LinkMetrics link_metrics(const json& facility_config, const std::string& link_name) const
+  {
+    if (facility_config.contains("links"))
+      for (const auto& link_cfg : facility_config["links"])
+        if (link_cfg["name"] == link_name)
+          return {xbt_parse_get_bandwidth(config_path_, 0, link_cfg["bandwidth"], "bandwidth"),
+                  xbt_parse_get_time(config_path_, 0, link_cfg.value("latency", "0s"), "latency")};
+    throw std::runtime_error("Unknown link '" + link_name + "' in interconnect of " + config_path_);
+  }
+
+  void emit_routes(const std::string& parent, const json& routes_config)
+  {
+    for (const auto& route_cfg : routes_config) {
+      out_ << "  " << parent << "->add_route(" << lookup(zone_vars_, route_cfg["src"], "zone") << ", "
+           << lookup(zone_vars_, route_cfg["dst"], "zone") << ", {";
+      const char* sep = "";
+      for (const auto& link_name : route_cfg["links"]) {
+        out_ << sep << "sg4::LinkInRoute(" << lookup(link_vars_, link_name, "link") << ")";
+        sep = ", ";
+      }
+      out_ << "}, true);\n";
+    }
+  }
+
+  void emit_filesystems(const json& filesystems_config, const json& platform_config)
+  {
+    for (const auto& fs_cfg : filesystems_config) {
+      const std::string fs_name = fs_cfg["name"];
+      const std::string pattern = fs_cfg["mount_point"];
+      const std::string fs_size = size(fs_cfg["size"]);
+      const std::string var     = new_var("fs");
+      // Lazy partitions are mounted at run time by libplatform.so's materialize_partitions()
+      if (fs_cfg.value("lazy", false))
+        throw std::runtime_error("'lazy' in filesystem " + fs_name + " is not supported by platform_codegen");
+
+      out_ << "  // Filesystem " << fs_name << "\n"
+           << "  auto " << var << " = sgfs::FileSystem::create(" << quote(fs_name) << ", 100000000);\n";
+      if (fs_cfg.contains("storage_system")) {
+        const std::string storage_system = fs_cfg["storage_system"];
+        out_ << "  " << var << "->mount_partition(" << quote(pattern) << ", "
+             << lookup(storage_vars_, storage_system, "storage system") << ", " << fs_size << ");\n"
+             << "  sgfs::FileSystem::register_file_system(" << lookup(zone_vars_, storage_system, "zone") << ", "
+             << var << ");\n\n";
+      } else if (fs_cfg.contains("cluster")) {
+        const std::string cluster_name = fs_cfg["cluster"];
+        const json* cluster            = find_cluster(platform_config["facilities"], cluster_name);
+        if (cluster == nullptr)
+          throw std::runtime_error("Unknown cluster '" + cluster_name + "' for filesystem " + fs_name);
+
+        // Split the mount point around {hostname} once, here
+        std::string mount_point_expr;
+        std::string rest = pattern;
+        size_t pos;
+        while ((pos = rest.find("{hostname}")) != std::string::npos) {
+          if (pos > 0)
+            mount_point_expr += quote(rest.substr(0, pos)) + " + ";
+          mount_point_expr += "hostname + ";
+          rest = rest.substr(pos + 10);
+        }
+        mount_point_expr += rest.empty() ? "\"\"" : quote(rest);
+
+        out_ << "  for (int i = 0; i < " << (*cluster)["count"].get<int>() << "; i++) {\n"
+             << "    const std::string hostname = indexed_name(" << quote((*cluster)["prefix"]) << ", i, "
+             << quote((*cluster)["suffix"]) << ");\n"
+             << "    " << var << "->mount_partition(std::string(" << mount_point_expr << "), "
+             << lookup(node_storage_vars_, cluster_name, "node storage of cluster") << "[i], " << fs_size << ");\n"
+             << "  }\n"
+             << "  sgfs::FileSystem::register_file_system(" << lookup(zone_vars_, cluster_name, "zone") << ", " << var
+             << ");\n\n";
+      }
+    }
+  }
+
+  // Facility or nested zone, with its children
+  void emit_zone(const std::string& parent, const json& zone_config)
+  {
+    const std::string zone_name = zone_config["name"];
+    const std::string routing   = zone_config.value("routing", "Full");
+    unsupported(zone_config, "graphs", "zone " + zone_name);
+    std::string create;
+    if (routing == "Full")
+      create = "add_netzone_full(" + quote(zone_name) + ")";
+    else if (routing == "Floyd")
+      create = "add_netzone_floyd(" + quote(zone_name) + ")";
+    else if (routing == "Dijkstra")
+      create = "add_netzone_dijkstra(" + quote(zone_name) + ", true)";
+    else
+      throw std::runtime_error("Unknown routing '" + routing + "' for zone " + zone_name +
+                               " (expected Full, Floyd or Dijkstra)");
+    const std::string zone = new_var("zone");
+    zone_vars_[zone_name]  = zone;
+    out_ << "  // " << (parent == "root" ? "Facility " : "Zone ") << zone_name << "\n"
+         << "  auto* " << zone << " = " << parent << "->" << create << ";\n\n";
+
+    if (zone_config.contains("storage_systems"))
+      for (const auto& storage_cfg : zone_config["storage_systems"])
+        emit_storage_system(zone, storage_cfg);
+    if (zone_config.contains("clusters"))
+      for (const auto& cluster_cfg : zone_config["clusters"])
+        emit_cluster(zone, cluster_cfg);
+    if (zone_config.contains("zones"))
+      for (const auto& child_cfg : zone_config["zones"])
+        emit_zone(zone, child_cfg);
+    if (zone_config.contains("links"))
+      emit_links(zone, zone_config["links"]);
+    if (zone_config.contains("routes"))
+      emit_routes(zone, zone_config["routes"]);
+    if (zone_config.contains("interconnect")) {
+      auto metrics = [this, &zone_config](const std::string& name) { return link_metrics(zone_config, name); };
+      emit_routes(zone, to_routes_config(compute_interconnect_routes(zone_config, metrics)));
+    }
+
+    out_ << "  " << zone << "->set_gateway(" << zone << "->add_router(" << quote(zone_name + "_router") << "));\n"
+         << "  " << zone << "->seal();\n\n";
+  }
+
+  // Cluster configuration by name, in any facility or nested zone
+  static const json* find_cluster(const json& zones_config, const std::string& cluster_name)
+  {
+    for (const auto& zone_config : zones_config) {
+      if (zone_config.contains("clusters"))
+        for (const auto& c : zone_config["clusters"])
+          if (c["name"] == cluster_name)
+            return &c;
+      if (zone_config.contains("zones"))
+        if (const json* cluster = find_cluster(zone_config["zones"], cluster_name))
+          return cluster;
+    }
+    return nullptr;
+  }
+
+public:
+  explicit CodeGenerator(std::string config_path) : config_path_(std::move(config_path)) {}
+
+  std::string generate(const json& config, const std::string& symbol)
+  {
+    // Compact names are reproduced; the optional name map is only written by libplatform.so
+    const std::string naming = config.value("naming", "readable");
+    if (naming != "readable" && naming != "compact")
+      throw std::runtime_error("Unknown naming '" + naming + "' (expected readable or compact)");
+    compact_names_ = naming == "compact";
+    // Generated platforms copy the properties into the hosts, and have no host_properties() table to share them
+    if (config.value("host_properties", "copy") != "copy")
+      unsupported(config, "host_properties", "the configuration");
+
+    out_ << "// Generated by platform_codegen from " << config_path_ << ". Do not edit.\n\n"
+         << "#include <charconv>\n"
+         << "#include <memory>\n"
+         << "#include <string>\n"
+         << "#include <string_view>\n"
+         << "#include <unordered_map>\n"
+         << "#include <vector>\n\n"
+         << "#include <fsmod/FileSystem.hpp>\n"
+         << "#include <fsmod/JBODStorage.hpp>\n"
+         << "#include <fsmod/OneDiskStorage.hpp>\n"
+         << "#include <simgrid/s4u.hpp>\n\n"
+         << "namespace sg4  = simgrid::s4u;\n"
+         << "namespace sgfs = simgrid::fsmod;\n\n"
+         << "static std::string indexed_name(std::string_view prefix, int index, std::string_view suffix)\n"
+         << "{\n"
+         << "  char digits[16];\n"
+         << "  auto end = std::to_chars(digits, digits + sizeof(digits), index).ptr;\n"
+         << "  std::string name;\n"
+         << "  name.reserve(prefix.size() + (end - digits) + suffix.size());\n"
+         << "  name.append(prefix).append(digits, end).append(suffix);\n"
+         << "  return name;\n"
+         << "}\n\n"
+         << "extern \"C\" void " << symbol << "(const sg4::Engine& e);\n"
+         << "void " << symbol << "(const sg4::Engine& e)\n"
+         << "{\n"
+         << "  auto* root = e.get_netzone_root();\n\n";
+
+    for (const auto& dc_config : config["facilities"])
+      emit_zone("root", dc_config);
+
+    if (config.contains("storage_systems"))
+      for (const auto& storage_cfg : config["storage_systems"])
+        emit_storage_system("root", storage_cfg);
+    if (config.contains("links"))
+      emit_links("root", config["links"]);
+    if (config.contains("routes"))
+      emit_routes("root", config["routes"]);
+    if (config.contains("filesystems"))
+      emit_filesystems(config["filesystems"], config);
+
+    out_ << "}\n";
+    return out_.str();
+  }
+};
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " <config.json> [-o output.cpp] [--symbol name]\n\n"
+            << "Generate a C++ translation unit that builds the platform described by a JSON configuration.\n\n"
+            << "Options:\n"
+            << "  -o output.cpp  Output file (default: standard output)\n"
+            << "  --symbol name  Name of the generated loader function (default: load_platform)\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::string config_path = argv[1];
+  if (config_path == "-h" || config_path == "--help") {
+    print_usage(argv[0]);
+    return 0;
+  }
+
+  std::string output_path;
+  std::string symbol = "load_platform";
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output_path = argv[++i];
+    } else if (strcmp(argv[i], "--symbol") == 0 && i + 1 < argc) {
+      symbol = argv[++i];
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    std::cerr << "Cannot open config file: " << config_path << "\n";
+    return 1;
+  }
+  json config = expand_config(json::parse(config_file));
+
+  std::string code;
+  try {
+    code = CodeGenerator(config_path).generate(config, symbol);
+  } catch (const std::exception& ex) {
+    std::cerr << "platform_codegen: " << ex.what() << "\n";
+    return 1;
+  }
+
+  if (output_path.empty()) {
+    std::cout << code;
+  } else {
+    std::ofstream output(output_path);
+    output << code;
+    if (!output) {
+      std::cerr << "Cannot write " << output_path << "\n";
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,676 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file platform_compact.cpp
+ * @brief Rewrite an exploded JSON platform configuration into compact form.
+ *
+ * Configurations generated from inventories list every cluster, link and
+ * route. This tool expands the configuration (see config_expander.hpp), then:
+ *   - replaces the explicit routes of a zone by an "interconnect" when the
+ *     routes are direct links or pairs of uplinks through a common switch,
+ *     and the interconnect induces exactly the same routes;
+ *   - turns runs of 3 or more list elements that only differ by integers
+ *     counting up (rack1, rack2, ... with r01n, r02n, ...) into "repeat"
+ *     constructs, innermost lists first;
+ *   - moves the common part of identical clusters and storage systems (all
+ *     but their names, prefixes and suffixes) into "templates".
+ * The loader then builds both configurations in forked processes, and the
+ * compact one is written only if the two platforms have the same fingerprint:
+ * zone tree, hosts (speed, cores, properties, disks), links, and the route
+ * between the first hosts of every pair of zones.
+ *
+ * Usage: platform_compact <config.json> -o <compact.json> [--lib libplatform.so] [--no-verify]
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <simgrid/s4u.hpp>
+#include <xbt/parse_units.hpp>
+
+#include "config_expander.hpp"
+#include "interconnect.hpp"
+
+namespace sg4 = simgrid::s4u;
+using json    = nlohmann::json;
+
+constexpr size_t min_repeat_run = 3;
+
+struct CompactStats {
+  size_t generated_routes = 0; // Zones whose routes became an interconnect
+  size_t repeats          = 0;
+  size_t repeated         = 0; // List elements folded into repeats
+  size_t templates        = 0;
+};
+
+/* ---------- Generated routes ---------- */
+
+using RouteKey = std::tuple<std::string, std::string, std::vector<std::string>>;
+
+// Routes are symmetric: orient them from the smaller zone name
+RouteKey route_key(std::string src, std::string dst, std::vector<std::string> links)
+{
+  if (dst < src) {
+    std::swap(src, dst);
+    std::reverse(links.begin(), links.end());
+  }
+  return {src, dst, links};
+}
+
+LinkMetrics link_metrics(const json& zone_config, const std::string& link_name)
+{
+  for (const auto& link_cfg : zone_config["links"])
+    if (link_cfg["name"] == link_name)
+      return {xbt_parse_get_bandwidth("", 0, link_cfg["bandwidth"], "bandwidth"),
+              xbt_parse_get_time("", 0, link_cfg.value("latency", "0s"), "latency")};
+  throw std::runtime_error("Unknown link '" + link_name + "' in interconnect");
+}
+
+// Replace the routes of a zone by an interconnect inducing the same routes; false if there is none
+bool generate_routes(json& zone_config)
+{
+  if (not zone_config.contains("routes") || zone_config.contains("interconnect") || not zone_config.contains("links"))
+    return false;
+
+  std::set<std::string> zone_names;
+  for (const char* key : {"storage_systems", "clusters", "graphs", "zones"})
+    if (zone_config.contains(key))
+      for (const auto& child : zone_config[key])
+        zone_names.insert(child["name"].get<std::string>());
+  std::string router = "core";
+  for (int n = 1; zone_names.count(router) > 0; n++)
+    router = "core" + std::to_string(n);
+
+  std::set<RouteKey> routes;
+  std::set<std::tuple<std::string, std::string, std::string>> edges;
+  json edges_config = json::array();
+  auto add_edge     = [&](const std::string& src, const std::string& dst, const std::string& link) {
+    if (edges.insert({src, dst, link}).second)
+      edges_config.push_back({{"src", src}, {"dst", dst}, {"link", link}});
+  };
+  for (const auto& route_cfg : zone_config["routes"]) {
+    const std::string src = route_cfg["src"];
+    const std::string dst = route_cfg["dst"];
+    const auto links      = route_cfg["links"].get<std::vector<std::string>>();
+    if (not routes.insert(route_key(src, dst, links)).second)
+      return false;
+    if (links.size() == 1) {
+      add_edge(src, dst, links[0]);
+    } else if (links.size() == 2) {
+      add_edge(src, router, links[0]);
+      add_edge(dst, router, links[1]);
+    } else {
+      return false;
+    }
+  }
+
+  json candidate = zone_config;
+  candidate.erase("routes");
+  candidate["interconnect"] = {{"edges", edges_config}};
+  std::set<RouteKey> generated;
+  try {
+    auto metrics = [&candidate](const std::string& name) { return link_metrics(candidate, name); };
+    for (const auto& route : compute_interconnect_routes(candidate, metrics))
+      generated.insert(route_key(route.src, route.dst, route.links));
+  } catch (const std::exception&) {
+    return false;
+  }
+  if (generated != routes)
+    return false;
+  zone_config = std::move(candidate);
+  return true;
+}
+
+void generate_zone_routes(json& zones_config, CompactStats& stats)
+{
+  for (auto& zone_config : zones_config) {
+    if (zone_config.contains("zones"))
+      generate_zone_routes(zone_config["zones"], stats);
+    if (generate_routes(zone_config))
+      stats.generated_routes++;
+  }
+}
+
+/* ---------- Repeats ---------- */
+
+// Integers (digit runs) of the strings of a list element, in traversal order, and the element without them
+struct Shape {
+  json skeleton;
+  std::vector<std::string> numbers;
+};
+
+void make_shape(const json& node, json& skeleton, std::vector<std::string>& numbers)
+{
+  if (node.is_string()) {
+    const std::string& text = node.get_ref<const std::string&>();
+    std::string stripped;
+    for (size_t i = 0; i < text.size();) {
+      if (std::isdigit(static_cast<unsigned char>(text[i]))) {
+        size_t end = i;
+        while (end < text.size() && std::isdigit(static_cast<unsigned char>(text[end])))
+          end++;
+        numbers.push_back(text.substr(i, end - i));
+        stripped.push_back('\x01');
+        i = end;
+      } else {
+        stripped.push_back(text[i++]);
+      }
+    }
+    skeleton = stripped;
+  } else if (node.is_object()) {
+    skeleton = json::object();
+    for (const auto& [key, value] : node.items())
+      make_shape(value, skeleton[key], numbers);
+  } else if (node.is_array()) {
+    skeleton = json::array();
+    for (const auto& value : node) {
+      skeleton.push_back(nullptr);
+      make_shape(value, skeleton.back(), numbers);
+    }
+  } else {
+    skeleton = node;
+  }
+}
+
+Shape make_shape(const json& element)
+{
+  Shape shape;
+  make_shape(element, shape.skeleton, shape.numbers);
+  return shape;
+}
+
+// How an integer of the first element of a run varies: constant, or start + k + offset at the k-th element
+struct NumberPattern {
+  bool varies = false;
+  long offset = 0;
+  int width   = 0; // Zero-padded width, 0 if not padded
+};
+
+bool comparable(const std::string& number)
+{
+  return number.size() <= 15;
+}
+
+bool padded(const std::string& number)
+{
+  return number.size() > 1 && number[0] == '0';
+}
+
+// Patterns of a run starting with @p first and @p second, or none if they do not form a run
+bool find_patterns(const Shape& first, const Shape& second, std::vector<NumberPattern>& patterns, long& start)
+{
+  if (first.skeleton != second.skeleton)
+    return false;
+  patterns.assign(first.numbers.size(), {});
+  bool any = false;
+  for (size_t p = 0; p < first.numbers.size(); p++) {
+    const auto& a = first.numbers[p];
+    const auto& b = second.numbers[p];
+    if (a == b)
+      continue;
+    if (not comparable(a) || not comparable(b) || std::stol(b) - std::stol(a) != 1)
+      return false;
+    if (not any)
+      start = std::stol(a);
+    any                = true;
+    patterns[p].varies = true;
+    patterns[p].offset = std::stol(a) - start;
+    if (padded(a) || padded(b))
+      patterns[p].width = static_cast<int>(a.size());
+  }
+  return any;
+}
+
+bool matches(const Shape& shape, const Shape& first, const std::vector<NumberPattern>& patterns, long start, long k)
+{
+  if (shape.skeleton != first.skeleton)
+    return false;
+  for (size_t p = 0; p < patterns.size(); p++) {
+    const auto& number = shape.numbers[p];
+    if (not patterns[p].varies) {
+      if (number != first.numbers[p])
+        return false;
+      continue;
+    }
+    if (not comparable(number) || std::stol(number) != start + k + patterns[p].offset)
+      return false;
+    // Padded numbers keep their width, unpadded ones have none
+    if (patterns[p].width > 0 ? static_cast<int>(number.size()) != patterns[p].width : padded(number))
+      return false;
+  }
+  return true;
+}
+
+// The first element of a run with its varying integers replaced by placeholders
+void make_template(json& node, const std::vector<NumberPattern>& patterns, const std::string& var, size_t& p)
+{
+  if (node.is_string()) {
+    const std::string text = node.get<std::string>();
+    std::string result;
+    for (size_t i = 0; i < text.size();) {
+      if (not std::isdigit(static_cast<unsigned char>(text[i]))) {
+        result.push_back(text[i++]);
+        continue;
+      }
+      size_t end = i;
+      while (end < text.size() && std::isdigit(static_cast<unsigned char>(text[end])))
+        end++;
+      const auto& pattern = patterns[p++];
+      if (pattern.varies) {
+        result.append("{").append(var);
+        if (pattern.offset != 0)
+          result.append(pattern.offset > 0 ? "+" : "").append(std::to_string(pattern.offset));
+        if (pattern.width > 0)
+          result.append(":0").append(std::to_string(pattern.width));
+        result.append("}");
+      } else {
+        result.append(text, i, end - i);
+      }
+      i = end;
+    }
+    node = result;
+  } else if (node.is_structured()) {
+    for (auto& child : node)
+      make_template(child, patterns, var, p);
+  }
+}
+
+// A repeat variable that no placeholder of the run uses yet
+std::string free_variable(const json& elements, size_t first, size_t last)
+{
+  for (const char* var : {"i", "j", "k", "l", "m", "n"}) {
+    bool used = false;
+    for (size_t e = first; e < last && not used; e++)
+      used = elements[e].dump().find(std::string("{") + var) != std::string::npos;
+    if (not used)
+      return var;
+  }
+  return "";
+}
+
+void fold_repeats(json& node, CompactStats& stats)
+{
+  if (node.is_object()) {
+    for (auto& child : node)
+      fold_repeats(child, stats);
+    return;
+  }
+  if (not node.is_array())
+    return;
+
+  for (auto& element : node)
+    fold_repeats(element, stats);
+  if (node.size() < min_repeat_run ||
+      not std::all_of(node.begin(), node.end(), [](const json& element) { return element.is_object(); }))
+    return;
+
+  std::vector<Shape> shapes;
+  for (const auto& element : node)
+    shapes.push_back(make_shape(element));
+
+  json folded = json::array();
+  size_t e    = 0;
+  while (e < node.size()) {
+    std::vector<NumberPattern> patterns;
+    long start  = 0;
+    size_t last = e + 1;
+    if (e + 1 < node.size() && not node[e].contains("repeat") &&
+        find_patterns(shapes[e], shapes[e + 1], patterns, start)) {
+      while (last < node.size() && not node[last].contains("repeat") &&
+             matches(shapes[last], shapes[e], patterns, start, static_cast<long>(last - e)))
+        last++;
+    }
+    std::string var = last - e >= min_repeat_run ? free_variable(node, e, last) : "";
+    if (var.empty()) {
+      folded.push_back(node[e]);
+      e++;
+      continue;
+    }
+
+    json element = node[e];
+    size_t p     = 0;
+    make_template(element, patterns, var, p);
+    json repeat = {{"count", last - e}};
+    if (start != 0)
+      repeat["start"] = start;
+    if (var != "i")
+      repeat["var"] = var;
+    element["repeat"] = repeat;
+    folded.push_back(std::move(element));
+    stats.repeats++;
+    stats.repeated += last - e;
+    e = last;
+  }
+  node = std::move(folded);
+}
+
+/* ---------- Templates ---------- */
+
+void collect_elements(json& node, const std::string& key, std::vector<json*>& elements)
+{
+  if (node.is_object()) {
+    for (auto& [child_key, child] : node.items()) {
+      if (child_key == key && child.is_array())
+        for (auto& element : child)
+          elements.push_back(&element);
+      collect_elements(child, key, elements);
+    }
+  } else if (node.is_array()) {
+    for (auto& child : node)
+      collect_elements(child, key, elements);
+  }
+}
+
+// Move the common part of identical list elements into templates named "<kind>-<n>"
+void share_definitions(json& config, json& templates, const std::string& list_key, const std::string& kind,
+                       CompactStats& stats)
+{
+  static const std::vector<std::string> identity = {"name", "prefix", "suffix", "repeat"};
+  std::vector<json*> elements;
+  collect_elements(config, list_key, elements);
+
+  std::map<std::string, std::vector<json*>> groups;
+  for (json* element : elements) {
+    if (not element->is_object() || element->contains("template"))
+      continue;
+    json common = *element;
+    for (const auto& key : identity)
+      common.erase(key);
+    if (common.size() > 1)
+      groups[common.dump()].push_back(element);
+  }
+
+  int n = 0;
+  for (auto& [common, members] : groups) {
+    if (members.size() < 2)
+      continue;
+    std::string name;
+    do
+      name = kind + "-" + std::to_string(++n);
+    while (templates.contains(name));
+    templates[name] = json::parse(common);
+    for (json* element : members) {
+      json reference = {{"template", name}};
+      for (const auto& key : identity)
+        if (element->contains(key))
+          reference[key] = (*element)[key];
+      *element = std::move(reference);
+    }
+    stats.templates++;
+  }
+}
+
+json compact_config(const json& config, CompactStats& stats)
+{
+  json result = expand_config(config);
+  generate_zone_routes(result["facilities"], stats);
+  fold_repeats(result, stats);
+
+  json templates = json::object();
+  share_definitions(result, templates, "clusters", "cluster", stats);
+  share_definitions(result, templates, "storage_systems", "storage", stats);
+  if (not templates.empty())
+    result["templates"] = templates;
+  return result;
+}
+
+/* ---------- Verification ---------- */
+
+struct Fingerprint {
+  bool ok       = false;
+  uint64_t hash = 1469598103934665603ULL; // FNV-1a
+  size_t zones  = 0;
+  size_t hosts  = 0;
+  size_t links  = 0;
+  size_t routes = 0;
+
+  void add(const std::string& line)
+  {
+    for (unsigned char c : line) {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    hash ^= '\n';
+    hash *= 1099511628211ULL;
+  }
+};
+
+void fingerprint_zone(const sg4::NetZone* zone, const std::string& path, Fingerprint& fp,
+                      std::vector<const sg4::Host*>& zone_hosts)
+{
+  fp.add("Z " + path);
+  fp.zones++;
+
+  std::vector<const sg4::Host*> hosts;
+  for (const auto* host : zone->get_all_hosts())
+    if (host->get_englobing_zone() == zone)
+      hosts.push_back(host);
+  std::sort(hosts.begin(), hosts.end(),
+            [](const sg4::Host* a, const sg4::Host* b) { return a->get_name() < b->get_name(); });
+  for (const auto* host : hosts) {
+    std::ostringstream oss;
+    oss << "H " << host->get_name() << " " << host->get_speed() << " " << host->get_core_count();
+    if (const auto* properties = host->get_properties()) {
+      std::map<std::string, std::string> sorted(properties->begin(), properties->end());
+      for (const auto& [key, value] : sorted)
+        oss << " " << key << "=" << value;
+    }
+    for (const auto* disk : host->get_disks())
+      oss << " D " << disk->get_name() << " " << disk->get_read_bandwidth() << " " << disk->get_write_bandwidth();
+    fp.add(oss.str());
+    fp.hosts++;
+  }
+  if (not hosts.empty())
+    zone_hosts.push_back(hosts.front());
+
+  auto children = zone->get_children();
+  std::sort(children.begin(), children.end(),
+            [](const sg4::NetZone* a, const sg4::NetZone* b) { return a->get_name() < b->get_name(); });
+  for (const auto* child : children)
+    fingerprint_zone(child, path + "/" + child->get_name(), fp, zone_hosts);
+}
+
+// Load @p config_path with the loader in a forked child and fingerprint the platform
+Fingerprint fingerprint(const std::string& lib_path, const std::string& config_path)
+{
+  Fingerprint result;
+  int fds[2];
+  if (pipe(fds) != 0)
+    return result;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    setenv("PLATFORM_CONFIG", config_path.c_str(), 1);
+    Fingerprint fp;
+    try {
+      std::string prog = "platform_compact";
+      std::string log  = "--log=root.thresh:critical";
+      int argc         = 2;
+      char* argv[]     = {prog.data(), log.data(), nullptr};
+      sg4::Engine e(&argc, argv);
+      e.load_platform(lib_path);
+
+      std::vector<const sg4::Host*> zone_hosts;
+      fingerprint_zone(e.get_netzone_root(), e.get_netzone_root()->get_name(), fp, zone_hosts);
+
+      auto links = e.get_all_links();
+      std::sort(links.begin(), links.end(),
+                [](const sg4::Link* a, const sg4::Link* b) { return a->get_name() < b->get_name(); });
+      for (const auto* link : links) {
+        std::ostringstream oss;
+        oss << "L " << link->get_name() << " " << link->get_bandwidth() << " " << link->get_latency() << " "
+            << static_cast<int>(link->get_sharing_policy());
+        fp.add(oss.str());
+        fp.links++;
+      }
+
+      for (const auto* src : zone_hosts)
+        for (const auto* dst : zone_hosts) {
+          std::vector<sg4::Link*> route;
+          double latency = 0;
+          src->route_to(dst, route, &latency);
+          std::ostringstream oss;
+          oss << "R " << src->get_name() << " " << dst->get_name() << " " << latency;
+          for (const auto* link : route)
+            oss << " " << link->get_name();
+          fp.add(oss.str());
+          fp.routes++;
+        }
+      fp.ok = true;
+    } catch (const std::exception& ex) {
+      std::cerr << "  " << config_path << ": " << ex.what() << "\n";
+    }
+    if (write(fds[1], &fp, sizeof(fp)) != sizeof(fp))
+      _exit(2);
+    _exit(0); // Skip the engine teardown
+  }
+
+  close(fds[1]);
+  if (pid > 0) {
+    if (read(fds[0], &result, sizeof(result)) != sizeof(result))
+      result.ok = false;
+    int status;
+    waitpid(pid, &status, 0);
+    if (not WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      result.ok = false;
+  }
+  close(fds[0]);
+  return result;
+}
+
+std::string default_library_path()
+{
+  char exe[4096];
+  ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  if (len <= 0)
+    return "libplatform.so";
+  exe[len] = '\0';
+  std::string dir(exe);
+  return dir.substr(0, dir.rfind('/') + 1) + "libplatform.so";
+}
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " <config.json> -o <compact.json> [options]\n\n"
+            << "Rewrite a JSON platform configuration with templates, repeats and generated routes, and check that\n"
+            << "the loader builds the same platform from both.\n\n"
+            << "Options:\n"
+            << "  -o file      Compact configuration to write (relative paths are kept: write it next to the input)\n"
+            << "  --lib path   JSON loader library (default: libplatform.so next to this tool)\n"
+            << "  --no-verify  Do not load the two configurations to compare them\n";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::string config_path = argv[1];
+  if (config_path == "-h" || config_path == "--help") {
+    print_usage(argv[0]);
+    return 0;
+  }
+
+  std::string output_path;
+  std::string lib_path = default_library_path();
+  bool verify          = true;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output_path = argv[++i];
+    } else if (strcmp(argv[i], "--lib") == 0 && i + 1 < argc) {
+      lib_path = argv[++i];
+    } else if (strcmp(argv[i], "--no-verify") == 0) {
+      verify = false;
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+  if (output_path.empty()) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    std::cerr << "Cannot open config file: " << config_path << "\n";
+    return 1;
+  }
+  std::stringstream buffer;
+  buffer << config_file.rdbuf();
+  const std::string original = buffer.str();
+
+  CompactStats stats;
+  json compact;
+  try {
+    compact = compact_config(json::parse(original), stats);
+  } catch (const std::exception& ex) {
+    std::cerr << "platform_compact: " << ex.what() << "\n";
+    return 1;
+  }
+  const std::string output = compact.dump(2) + "\n";
+
+  std::cout << config_path << ": " << original.size() << " bytes -> " << output.size() << " bytes ("
+            << stats.repeated << " list elements in " << stats.repeats << " repeats, " << stats.templates
+            << " templates, routes generated in " << stats.generated_routes << " zones)\n";
+
+  if (verify) {
+    // Load copies next to the input, so that relative paths resolve, without the loader's side outputs
+    const std::filesystem::path dir = std::filesystem::path(config_path).parent_path();
+    const std::string base          = (dir / (".platform_compact_" + std::to_string(getpid()))).string();
+    json before                     = json::parse(original);
+    json after                      = compact;
+    for (json* cfg : {&before, &after}) {
+      cfg->erase("name_map");
+      cfg->erase("topology_index");
+    }
+    std::ofstream(base + "_before.json") << before.dump();
+    std::ofstream(base + "_after.json") << after.dump();
+    Fingerprint expected = fingerprint(lib_path, base + "_before.json");
+    Fingerprint actual   = fingerprint(lib_path, base + "_after.json");
+    unlink((base + "_before.json").c_str());
+    unlink((base + "_after.json").c_str());
+
+    if (not expected.ok || not actual.ok) {
+      std::cerr << "Cannot load " << (expected.ok ? "the compact configuration" : config_path) << "\n";
+      return 1;
+    }
+    if (expected.hash != actual.hash) {
+      std::cerr << "The compact configuration builds another platform (" << actual.zones << " zones, " << actual.hosts
+                << " hosts, " << actual.links << " links instead of " << expected.zones << ", " << expected.hosts
+                << ", " << expected.links << "); nothing written\n";
+      return 1;
+    }
+    std::cout << "Same platform: " << expected.zones << " zones, " << expected.hosts << " hosts, " << expected.links
+              << " links, " << expected.routes << " routes compared\n";
+  }
+
+  std::ofstream output_file(output_path);
+  if (!output_file.is_open()) {
+    std::cerr << "Cannot write " << output_path << "\n";
+    return 1;
+  }
+  output_file << output;
+  return 0;
+}
@@ -0,0 +1,185 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file platform_index.cpp
+ * @brief Utility to write and inspect topology index files.
+ *
+ * This tool writes the binary topology index of a JSON platform configuration
+ * (see topology_index.hpp) without building the SimGrid platform, or reads an
+ * existing index back through the header-only reader, as external tools do.
+ *
+ * Usage: platform_index <config.json> -o <index>
+ *        platform_index --show <index> [--host NAME]...
+ */
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "config_expander.hpp"
+#include "index_writer.hpp"
+#include "topology_index.hpp"
+
+using json = nlohmann::json;
+
+void print_usage(const char* prog_name)
+{
+  std::cerr << "Usage: " << prog_name << " <config.json> -o <index>\n"
+            << "       " << prog_name << " --show <index> [--host NAME]...\n\n"
+            << "Write the topology index of a JSON platform configuration, or display an existing index.\n\n"
+            << "Options:\n"
+            << "  -o index     Index file to write\n"
+            << "  --show index Display the zones and clusters of an index\n"
+            << "  --host NAME  With --show, display a host or VM (may be repeated)\n";
+}
+
+const char* zone_kind(ZoneKind kind)
+{
+  switch (kind) {
+    case ZoneKind::WORLD:
+      return "world";
+    case ZoneKind::ZONE:
+      return "zone";
+    case ZoneKind::CLUSTER:
+      return "cluster";
+    case ZoneKind::STORAGE_SYSTEM:
+      return "storage system";
+    case ZoneKind::GRAPH:
+      return "graph";
+  }
+  return "?";
+}
+
+int show_index(const std::string& index_path, const std::vector<std::string>& host_names)
+{
+  auto start = std::chrono::steady_clock::now();
+  TopologyIndex index(index_path);
+  double open_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << index_path << ": " << index.zones().size() << " zones, " << index.clusters().size() << " clusters, "
+            << index.hosts().size() << " hosts, " << index.disks().size() << " disks, " << index.links().size()
+            << " links, " << index.vms().size() << " VMs (opened in " << open_time * 1e6 << " us)\n";
+
+  if (host_names.empty()) {
+    std::vector<int> depth(index.zones().size(), 0);
+    for (size_t z = 1; z < index.zones().size(); z++) {
+      const auto& zone = index.zones()[z];
+      depth[z]         = depth[zone.parent] + 1;
+      std::cout << std::string(2 * depth[z], ' ') << index.str(zone.name) << " (" << zone_kind(zone.kind);
+      if (zone.host_count > 0)
+        std::cout << ", " << zone.host_count << " hosts";
+      std::cout << ")\n";
+    }
+    for (const auto& cluster : index.clusters())
+      std::cout << "cluster " << index.str(cluster.name) << ": " << index.str(cluster.prefix) << "[0-"
+                << cluster.count - 1 << "]" << index.str(cluster.suffix) << ", " << cluster.speed << " flop/s x "
+                << cluster.cores << ", links " << cluster.link_bandwidth << " B/s, backbone "
+                << cluster.backbone_bandwidth << " B/s"
+                << (cluster.rails > 1 ? " (rail 0 of " + std::to_string(cluster.rails) + ")" : "") << "\n";
+    for (const auto& pool : index.vm_pools())
+      std::cout << "vm pool " << index.str(pool.name) << " of " << index.str(index.clusters()[pool.cluster].name)
+                << ": " << pool.per_host << " per node, " << pool.cores << " cores, " << pool.ramsize
+                << " bytes of RAM\n";
+    return 0;
+  }
+
+  int status = 0;
+  for (const auto& name : host_names) {
+    const IndexHost* host = index.find_host(name);
+    if (const IndexVm* vm = host == nullptr ? index.find_vm(name) : nullptr) {
+      const auto& pool = index.vm_pools()[vm->pool];
+      std::cout << name << ": VM " << vm->slot << " of pool " << index.str(pool.name) << " on "
+                << index.str(index.hosts()[vm->host].name) << ", " << pool.cores << " cores\n";
+      continue;
+    }
+    if (host == nullptr) {
+      std::cout << name << ": not found\n";
+      status = 1;
+      continue;
+    }
+    std::cout << name << ": " << index.zone_path(host->zone) << ", " << host->speed << " flop/s x " << host->cores;
+    if (host->cluster != INDEX_NONE)
+      std::cout << ", node " << host->node_index << " of " << index.str(index.clusters()[host->cluster].name);
+    std::cout << "\n";
+    for (const auto& disk : index.host_disks(*host))
+      std::cout << "  disk " << index.str(disk.name) << " (storage " << index.str(disk.storage) << "), read "
+                << disk.read_bandwidth << " B/s, write " << disk.write_bandwidth << " B/s\n";
+  }
+  return status;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::string first = argv[1];
+  if (first == "-h" || first == "--help") {
+    print_usage(argv[0]);
+    return 0;
+  }
+
+  if (first == "--show") {
+    if (argc < 3) {
+      print_usage(argv[0]);
+      return 1;
+    }
+    std::vector<std::string> host_names;
+    for (int i = 3; i < argc; i++) {
+      if (strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+        host_names.emplace_back(argv[++i]);
+      } else {
+        print_usage(argv[0]);
+        return 1;
+      }
+    }
+    try {
+      return show_index(argv[2], host_names);
+    } catch (const std::exception& ex) {
+      std::cerr << ex.what() << "\n";
+      return 1;
+    }
+  }
+
+  std::string output_path;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output_path = argv[++i];
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+  if (output_path.empty()) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::ifstream config_file(first);
+  if (!config_file.is_open()) {
+    std::cerr << "Cannot open config file: " << first << "\n";
+    return 1;
+  }
+  json config = expand_config(json::parse(config_file));
+
+  try {
+    IndexStats stats = write_topology_index(config, std::filesystem::path(first).parent_path(), output_path);
+    std::cout << output_path << ": " << stats.zones << " zones, " << stats.clusters << " clusters, " << stats.hosts
+              << " hosts, " << stats.disks << " disks, " << stats.links << " links, " << stats.vms << " VMs, "
+              << stats.bytes << " bytes\n";
+  } catch (const std::exception& ex) {
+    std::cerr << ex.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
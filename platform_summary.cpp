@@ -12,18 +12,39 @@
  * hosts, and disks.
  *
  * Usage: platform_summary <platform_file> [simgrid-options]
+ *        platform_summary --batch <list.txt> [--jobs N] [--format csv|json]
+ *                         [--lib libplatform.so] [-o output]
  *
  * Supported formats:
  *   - .xml  : SimGrid XML platform file
  *   - .so   : Shared library with load_platform() function
  *   - .cpp  : (requires compilation) C++ platform description
+ *   - .json : (batch mode) JSON configuration, loaded through libplatform.so
+ *
+ * In batch mode, the list file names one platform per line (blank lines and
+ * lines starting with '#' are ignored, relative paths are relative to the list
+ * file). SimGrid builds a single platform per engine and a single engine per
+ * process, so every platform is loaded by its own forked worker, --jobs of them
+ * at a time. The per-platform counts, load time and peak RSS are merged into a
+ * single CSV or JSON table, in the order of the list.
  */
 
 #include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <unordered_map>
+#include <sstream>
 #include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 #include <fsmod/FileSystem.hpp>
@@ -32,22 +53,175 @@
 namespace sg4  = simgrid::s4u;
 namespace sgfs = simgrid::fsmod;
 
-void print_zone_tree(sg4::NetZone* zone, const std::string& indent = "") {
-  int host_count = 0;
-  for (auto* host : zone->get_all_hosts()) {
-    if (host->get_englobing_zone() == zone) {
-      host_count++;
+// Zone tree with the hosts of each zone counted once, and structurally identical subtrees (same number of hosts
+// in each zone, same children in the same order) sharing a shape
+struct ZoneTree {
+  struct Shape {
+    size_t zones = 1; // In the subtree, this zone included
+    size_t hosts = 0;
+  };
+  std::unordered_map<const sg4::NetZone*, size_t> direct_hosts;
+  std::unordered_map<const sg4::NetZone*, size_t> shape_of;
+  std::vector<Shape> shapes;
+};
+
+// Hash of a subtree: its direct host count followed by the shapes of its children
+struct ShapeKeyHash {
+  size_t operator()(const std::vector<size_t>& key) const {
+    size_t h = key.size();
+    for (size_t v : key) {
+      h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+};
+
+// Count the hosts of every zone with a single get_all_hosts(), then give each subtree its shape, bottom-up
+ZoneTree build_zone_tree(const sg4::Engine& e) {
+  ZoneTree tree;
+  for (auto* host : e.get_all_hosts()) {
+    tree.direct_hosts[host->get_englobing_zone()]++;
+  }
+
+  std::unordered_map<std::vector<size_t>, size_t, ShapeKeyHash> shape_ids;
+  std::function<size_t(const sg4::NetZone*)> visit = [&](const sg4::NetZone* zone) {
+    auto it = tree.direct_hosts.find(zone);
+    ZoneTree::Shape shape;
+    shape.hosts = it == tree.direct_hosts.end() ? 0 : it->second;
+    std::vector<size_t> key = {shape.hosts};
+    for (auto* child : zone->get_children()) {
+      size_t id = visit(child);
+      key.push_back(id);
+      shape.zones += tree.shapes[id].zones;
+      shape.hosts += tree.shapes[id].hosts;
+    }
+    auto [entry, inserted] = shape_ids.try_emplace(std::move(key), tree.shapes.size());
+    if (inserted) {
+      tree.shapes.push_back(shape);
+    }
+    tree.shape_of[zone] = entry->second;
+    return entry->second;
+  };
+  visit(e.get_netzone_root());
+  return tree;
+}
+
+std::string plural(size_t count, const std::string& noun) {
+  return std::to_string(count) + " " + noun + (count == 1 ? "" : "s");
+}
+
+// Names of a group of zones, such as site-[0-63] or r[01-08,12]n when they only differ by a number
+std::string fold_names(const std::vector<sg4::NetZone*>& zones) {
+  const std::string& first = zones.front()->get_name();
+  const std::string& last  = zones.back()->get_name();
+  auto is_digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+  size_t prefix = first.size();
+  size_t suffix = first.size();
+  for (const auto* zone : zones) {
+    const std::string& name = zone->get_name();
+    size_t common           = 0;
+    while (common < prefix && common < name.size() && first[common] == name[common]) {
+      common++;
+    }
+    prefix = common;
+    common = 0;
+    while (common < suffix && common < name.size() &&
+           first[first.size() - 1 - common] == name[name.size() - 1 - common]) {
+      common++;
+    }
+    suffix = common;
+  }
+  // The varying part is a whole number: no digit kept around it
+  while (prefix > 0 && is_digit(first[prefix - 1])) {
+    prefix--;
+  }
+  suffix = std::min(suffix, first.size() - prefix);
+  while (suffix > 0 && is_digit(first[first.size() - suffix])) {
+    suffix--;
+  }
+
+  std::vector<long> numbers;
+  size_t width = 0; // Of zero-padded numbers, 0 otherwise
+  for (const auto* zone : zones) {
+    const std::string& name = zone->get_name();
+    if (name.size() < prefix + suffix) {
+      return first + " .. " + last;
     }
+    const std::string middle = name.substr(prefix, name.size() - prefix - suffix);
+    if (middle.empty() || middle.size() > 18 || not std::all_of(middle.begin(), middle.end(), is_digit)) {
+      return first + " .. " + last;
+    }
+    if (middle.size() > 1 && middle[0] == '0') {
+      width = middle.size();
+    }
+    numbers.push_back(std::stol(middle));
   }
+  std::sort(numbers.begin(), numbers.end());
+
+  std::ostringstream out;
+  out << first.substr(0, prefix) << "[" << std::setfill('0');
+  for (size_t i = 0; i < numbers.size();) {
+    size_t j = i;
+    while (j + 1 < numbers.size() && numbers[j + 1] == numbers[j] + 1) {
+      j++;
+    }
+    out << (i == 0 ? "" : ",") << std::setw(static_cast<int>(width)) << numbers[i];
+    if (j > i) {
+      out << "-" << std::setw(static_cast<int>(width)) << numbers[j];
+    }
+    i = j + 1;
+  }
+  out << "]" << first.substr(first.size() - suffix);
+  return out.str();
+}
 
+void print_zone_children(const sg4::NetZone* zone, const ZoneTree& tree, bool fold, const std::string& indent);
+
+void print_zone_tree(const sg4::NetZone* zone, const ZoneTree& tree, bool fold, const std::string& indent = "") {
+  auto it = tree.direct_hosts.find(zone);
   std::cout << indent << zone->get_name();
-  if (host_count > 0) {
-    std::cout << " (" << host_count << " hosts)";
+  if (it != tree.direct_hosts.end()) {
+    std::cout << " (" << it->second << " hosts)";
   }
   std::cout << "\n";
+  print_zone_children(zone, tree, fold, indent + "  ");
+}
 
-  for (auto* child : zone->get_children()) {
-    print_zone_tree(child, indent + "  ");
+// Children of a zone; when folding, structurally identical siblings are grouped on one line, in the order of their
+// first member, followed by the children of that member
+void print_zone_children(const sg4::NetZone* zone, const ZoneTree& tree, bool fold, const std::string& indent) {
+  const auto children = zone->get_children();
+  if (not fold) {
+    for (auto* child : children) {
+      print_zone_tree(child, tree, fold, indent);
+    }
+    return;
+  }
+
+  std::vector<std::vector<sg4::NetZone*>> groups;
+  std::unordered_map<size_t, size_t> group_of_shape;
+  for (auto* child : children) {
+    auto [entry, inserted] = group_of_shape.try_emplace(tree.shape_of.at(child), groups.size());
+    if (inserted) {
+      groups.emplace_back();
+    }
+    groups[entry->second].push_back(child);
+  }
+  for (const auto& group : groups) {
+    const sg4::NetZone* first = group.front();
+    if (group.size() == 1) {
+      print_zone_tree(first, tree, fold, indent);
+      continue;
+    }
+    const auto& shape = tree.shapes[tree.shape_of.at(first)];
+    std::cout << indent << group.size() << "x " << fold_names(group) << " (" << plural(shape.zones, "zone") << ", "
+              << plural(shape.hosts, "host") << " each)";
+    if (first->get_children().empty()) {
+      std::cout << "\n";
+      continue;
+    }
+    std::cout << ", like " << first->get_name() << ":\n";
+    print_zone_children(first, tree, fold, indent + "  ");
   }
 }
 
@@ -119,14 +293,300 @@ void print_disk_summary(sg4::NetZone* zone) {
 }
 
 void print_usage(const char* prog_name) {
-  std::cerr << "Usage: " << prog_name << " <platform_file> [simgrid-options]\n\n"
+  std::cerr << "Usage: " << prog_name << " <platform_file> [--fold] [simgrid-options]\n"
+            << "       " << prog_name << " --batch <list.txt> [options]\n\n"
             << "Display a human-readable summary of a SimGrid platform.\n\n"
             << "Supported formats:\n"
             << "  .xml  : SimGrid XML platform file\n"
-            << "  .so   : Shared library with load_platform() function\n\n"
+            << "  .so   : Shared library with load_platform() function\n"
+            << "  .json : JSON configuration (batch mode, loaded through libplatform.so)\n\n"
+            << "Options:\n"
+            << "  --fold               Show structurally identical sibling zones once, as 64x site-[0-63]\n\n"
+            << "Batch options (one platform per line of list.txt, each loaded by a forked worker):\n"
+            << "  --jobs N             Number of concurrent workers (default: number of CPUs)\n"
+            << "  --format csv|json    Output format of the merged table (default: csv)\n"
+            << "  --lib path           JSON loader library (default: libplatform.so next to this tool)\n"
+            << "  -o path              Write the table to a file instead of stdout\n\n"
             << "Examples:\n"
             << "  " << prog_name << " platform.xml\n"
-            << "  " << prog_name << " libplatform.so\n";
+            << "  " << prog_name << " libplatform.so\n"
+            << "  " << prog_name << " libplatform.so --fold\n"
+            << "  " << prog_name << " --batch sweep.txt --format json -o sweep.json\n";
+}
+
+// Fixed-size record sent back by a batch worker through its pipe
+struct BatchRecord {
+  bool ok             = false;
+  double load_seconds = 0.0;
+  size_t zones        = 0;
+  size_t hosts        = 0;
+  size_t cores        = 0;
+  size_t disks        = 0;
+  size_t links        = 0;
+  double total_speed  = 0.0;
+  long max_rss_kb     = 0;
+  char error[256]     = "";
+};
+
+struct BatchEntry {
+  std::string platform; // As written in the list file
+  std::string path;     // Resolved path of the platform (or of libplatform.so for .json configs)
+  std::string config;   // JSON configuration, passed to libplatform.so through PLATFORM_CONFIG
+  BatchRecord record;
+};
+
+std::vector<BatchEntry> read_batch_list(const std::string& list_path, const std::string& lib_path)
+{
+  std::ifstream list(list_path);
+  if (!list.is_open()) {
+    throw std::runtime_error("Cannot open batch list: " + list_path);
+  }
+  const std::filesystem::path base_dir = std::filesystem::absolute(list_path).parent_path();
+
+  std::vector<BatchEntry> entries;
+  std::string line;
+  while (std::getline(list, line)) {
+    line.erase(0, line.find_first_not_of(" \t"));
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (line.empty() || line[0] == '#') continue;
+
+    BatchEntry entry;
+    entry.platform = line;
+    std::filesystem::path resolved = line;
+    if (resolved.is_relative()) resolved = base_dir / resolved;
+    if (resolved.extension() == ".json") {
+      entry.path   = lib_path;
+      entry.config = resolved.string();
+    } else {
+      entry.path = resolved.string();
+    }
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
+// Body of a batch worker: load one platform in a fresh engine and write its record to fd
+[[noreturn]] void run_batch_worker(const BatchEntry& entry, int fd)
+{
+  if (not entry.config.empty())
+    setenv("PLATFORM_CONFIG", entry.config.c_str(), 1);
+
+  BatchRecord record;
+  try {
+    std::string prog = "platform_summary";
+    std::string log  = "--log=root.thresh:critical";
+    int argc         = 2;
+    char* argv[]     = {prog.data(), log.data(), nullptr};
+    sg4::Engine e(&argc, argv);
+
+    auto start = std::chrono::steady_clock::now();
+    e.load_platform(entry.path);
+    record.load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::function<void(sg4::NetZone*)> count_zones = [&](sg4::NetZone* z) {
+      record.zones++;
+      for (auto* child : z->get_children()) {
+        count_zones(child);
+      }
+    };
+    count_zones(e.get_netzone_root());
+    for (const auto* host : e.get_all_hosts()) {
+      record.cores += host->get_core_count();
+      record.disks += host->get_disks().size();
+      record.total_speed += host->get_speed() * host->get_core_count();
+    }
+    record.hosts = e.get_host_count();
+    record.links = e.get_link_count();
+    record.ok    = true;
+  } catch (const std::exception& ex) {
+    strncpy(record.error, ex.what(), sizeof(record.error) - 1);
+  }
+  if (write(fd, &record, sizeof(record)) != sizeof(record))
+    _exit(2);
+  _exit(0); // The engine teardown is of no interest to the parent
+}
+
+// Load every entry in a forked worker, at most `jobs` at a time
+void run_batch(std::vector<BatchEntry>& entries, unsigned jobs)
+{
+  struct Running {
+    size_t index;
+    int fd;
+  };
+  std::map<pid_t, Running> running;
+  size_t next = 0;
+
+  while (next < entries.size() || not running.empty()) {
+    while (next < entries.size() && running.size() < jobs) {
+      int fds[2];
+      if (pipe(fds) != 0) {
+        throw std::runtime_error(std::string("pipe: ") + strerror(errno));
+      }
+      std::cout.flush();
+      std::cerr.flush();
+      pid_t pid = fork();
+      if (pid < 0) {
+        throw std::runtime_error(std::string("fork: ") + strerror(errno));
+      }
+      if (pid == 0) {
+        close(fds[0]);
+        run_batch_worker(entries[next], fds[1]);
+      }
+      close(fds[1]);
+      running[pid] = {next, fds[0]};
+      next++;
+    }
+
+    int status;
+    struct rusage usage;
+    pid_t pid = wait4(-1, &status, 0, &usage);
+    if (pid < 0) {
+      throw std::runtime_error(std::string("wait4: ") + strerror(errno));
+    }
+    auto it = running.find(pid);
+    if (it == running.end()) continue;
+
+    // Records are smaller than PIPE_BUF, so the worker never blocks on its write
+    BatchRecord& record = entries[it->second.index].record;
+    if (read(it->second.fd, &record, sizeof(record)) != sizeof(record)) {
+      record    = BatchRecord();
+      record.ok = false;
+      snprintf(record.error, sizeof(record.error), "worker died (%s %d)",
+               WIFSIGNALED(status) ? "signal" : "exit status",
+               WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+    }
+    record.max_rss_kb = usage.ru_maxrss;
+    close(it->second.fd);
+    running.erase(it);
+  }
+}
+
+std::string csv_field(const std::string& value)
+{
+  if (value.find_first_of(",\"\n") == std::string::npos) return value;
+  std::string quoted = "\"";
+  for (char c : value) {
+    if (c == '"') quoted += '"';
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+std::string json_string(const std::string& value)
+{
+  std::ostringstream oss;
+  oss << '"';
+  for (char c : value) {
+    switch (c) {
+      case '"': oss << "\\\""; break;
+      case '\\': oss << "\\\\"; break;
+      case '\n': oss << "\\n"; break;
+      case '\t': oss << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+          oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        else
+          oss << c;
+    }
+  }
+  oss << '"';
+  return oss.str();
+}
+
+void write_batch_csv(std::ostream& os, const std::vector<BatchEntry>& entries)
+{
+  os << "platform,status,load_seconds,peak_rss_mb,zones,hosts,cores,disks,links,total_gflops,error\n";
+  for (const auto& entry : entries) {
+    const auto& r = entry.record;
+    os << csv_field(entry.platform) << "," << (r.ok ? "ok" : "failed") << "," << std::fixed << std::setprecision(4)
+       << r.load_seconds << "," << std::setprecision(1) << r.max_rss_kb / 1024.0 << "," << r.zones << "," << r.hosts
+       << "," << r.cores << "," << r.disks << "," << r.links << "," << std::setprecision(3) << r.total_speed / 1e9
+       << "," << csv_field(r.error) << "\n";
+  }
+}
+
+void write_batch_json(std::ostream& os, const std::vector<BatchEntry>& entries)
+{
+  os << "[\n";
+  for (size_t i = 0; i < entries.size(); i++) {
+    const auto& r = entries[i].record;
+    os << "  {\"platform\": " << json_string(entries[i].platform) << ", \"status\": \"" << (r.ok ? "ok" : "failed")
+       << "\", \"load_seconds\": " << std::fixed << std::setprecision(6) << r.load_seconds
+       << ", \"peak_rss_mb\": " << std::setprecision(1) << r.max_rss_kb / 1024.0 << ", \"zones\": " << r.zones
+       << ", \"hosts\": " << r.hosts << ", \"cores\": " << r.cores << ", \"disks\": " << r.disks
+       << ", \"links\": " << r.links << ", \"total_gflops\": " << std::setprecision(3) << r.total_speed / 1e9;
+    if (not r.ok) os << ", \"error\": " << json_string(r.error);
+    os << "}" << (i + 1 < entries.size() ? "," : "") << "\n";
+  }
+  os << "]\n";
+}
+
+std::string default_library_path()
+{
+  char exe[4096];
+  ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  if (len <= 0) return "libplatform.so";
+  exe[len] = '\0';
+  std::string dir(exe);
+  return dir.substr(0, dir.rfind('/') + 1) + "libplatform.so";
+}
+
+int batch_main(int argc, char** argv)
+{
+  std::string list_path = argv[2];
+  std::string lib_path  = default_library_path();
+  std::string format    = "csv";
+  std::string output_path;
+  unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+  for (int i = 3; i < argc; i++) {
+    if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+      jobs = std::max(1, std::stoi(argv[++i]));
+    } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+      format = argv[++i];
+    } else if (strcmp(argv[i], "--lib") == 0 && i + 1 < argc) {
+      lib_path = argv[++i];
+    } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output_path = argv[++i];
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+  if (format != "csv" && format != "json") {
+    std::cerr << "Unknown format '" << format << "' (expected csv or json)\n";
+    return 1;
+  }
+
+  std::vector<BatchEntry> entries;
+  try {
+    entries = read_batch_list(list_path, lib_path);
+    auto start = std::chrono::steady_clock::now();
+    run_batch(entries, jobs);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t failed  = std::count_if(entries.begin(), entries.end(), [](const BatchEntry& b) { return not b.record.ok; });
+    std::cerr << entries.size() << " platform(s) summarized in " << std::fixed << std::setprecision(2) << elapsed
+              << " s with " << jobs << " worker(s), " << failed << " failed\n";
+  } catch (const std::exception& ex) {
+    std::cerr << ex.what() << "\n";
+    return 1;
+  }
+
+  std::ofstream output_file;
+  if (not output_path.empty()) {
+    output_file.open(output_path);
+    if (!output_file.is_open()) {
+      std::cerr << "Cannot write " << output_path << "\n";
+      return 1;
+    }
+  }
+  std::ostream& os = output_path.empty() ? std::cout : output_file;
+  if (format == "json")
+    write_batch_json(os, entries);
+  else
+    write_batch_csv(os, entries);
+
+  bool all_ok = std::all_of(entries.begin(), entries.end(), [](const BatchEntry& b) { return b.record.ok; });
+  return all_ok ? 0 : 2;
 }
 
 int main(int argc, char** argv)
@@ -144,6 +604,25 @@ int main(int argc, char** argv)
     return 0;
   }
 
+  if (platform_file == "--batch") {
+    if (argc < 3) {
+      print_usage(argv[0]);
+      return 1;
+    }
+    return batch_main(argc, argv);
+  }
+
+  // Removed before SimGrid sees the options
+  bool fold = false;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--fold") == 0) {
+      fold = true;
+      std::copy(argv + i + 1, argv + argc + 1, argv + i);
+      argc--;
+      i--;
+    }
+  }
+
   sg4::Engine e(&argc, argv);
   e.load_platform(platform_file);
 
@@ -168,7 +647,7 @@ int main(int argc, char** argv)
   std::cout << "\n=== PLATFORM SUMMARY ===\n\n";
 
   std::cout << "ZONE HIERARCHY:\n";
-  print_zone_tree(root);
+  print_zone_tree(root, build_zone_tree(e), fold);
 
   std::cout << "\nHOSTS (" << total_hosts << "):\n";
   print_host_summary(root);
@@ -0,0 +1,214 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file property_sets.hpp
+ * @brief Resolution of the host properties of a cluster into distinct property sets.
+ *
+ * A cluster may carry a "properties" object, applied to every node, and a list
+ * of "property_overrides", each adding or replacing properties on a range of
+ * nodes ("nodes": "0-63,128"). Later overrides win. The nodes are split into
+ * consecutive segments sharing the same properties, and each distinct set of
+ * properties is built once, whatever the number of segments or nodes using it.
+ *
+ * Shared by the loader and platform_codegen, so that both apply the same sets.
+ * The loader and the topology index writer also order the nodes by their
+ * "rack" property with rack_node_order(), for hosts_by_locality().
+ *
+ * Host::set_properties() copies a set into each host. NodePropertyTable keeps
+ * the sets once instead, with one entry per segment, for host_properties().
+ */
+
+#ifndef PROPERTY_SETS_HPP
+#define PROPERTY_SETS_HPP
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+using PropertySet = std::unordered_map<std::string, std::string>;
+
+struct PropertySegment {
+  int first;  // First node of the segment
+  int last;   // Last node of the segment (inclusive)
+  size_t set; // Index in ClusterProperties::sets
+};
+
+struct ClusterProperties {
+  std::vector<PropertySet> sets;
+  std::vector<PropertySegment> segments; // Sorted, covering the nodes that have at least one property
+
+  bool empty() const { return segments.empty(); }
+};
+
+// Parse a node range list such as "0-63,128,130-131" into inclusive intervals
+inline std::vector<std::pair<int, int>> parse_node_ranges(const std::string& ranges, int count,
+                                                          const std::string& cluster_name)
+{
+  std::vector<std::pair<int, int>> intervals;
+  size_t start = 0;
+  while (start <= ranges.size()) {
+    size_t end = ranges.find(',', start);
+    if (end == std::string::npos)
+      end = ranges.size();
+    const std::string item = ranges.substr(start, end - start);
+    try {
+      size_t dash = item.find('-');
+      int first   = std::stoi(item.substr(0, dash));
+      int last    = (dash == std::string::npos) ? first : std::stoi(item.substr(dash + 1));
+      if (first < 0 || last < first || last >= count)
+        throw std::out_of_range(item);
+      intervals.emplace_back(first, last);
+    } catch (const std::logic_error&) {
+      throw std::runtime_error("Invalid node range '" + item + "' in property overrides of cluster " + cluster_name +
+                               " (" + std::to_string(count) + " nodes)");
+    }
+    start = end + 1;
+  }
+  return intervals;
+}
+
+inline ClusterProperties resolve_cluster_properties(const nlohmann::json& cluster_config)
+{
+  ClusterProperties result;
+  const std::string name = cluster_config["name"];
+  const int count        = cluster_config["count"];
+  if (count <= 0 || (!cluster_config.contains("properties") && !cluster_config.contains("property_overrides")))
+    return result;
+
+  PropertySet base;
+  if (cluster_config.contains("properties"))
+    for (const auto& [key, value] : cluster_config["properties"].items())
+      base[key] = value.is_string() ? value.get<std::string>() : value.dump();
+
+  struct Override {
+    std::vector<std::pair<int, int>> intervals;
+    PropertySet properties;
+  };
+  std::vector<Override> overrides;
+  std::vector<int> boundaries = {0, count};
+  if (cluster_config.contains("property_overrides")) {
+    for (const auto& override_cfg : cluster_config["property_overrides"]) {
+      Override o;
+      o.intervals = parse_node_ranges(override_cfg["nodes"], count, name);
+      for (const auto& [key, value] : override_cfg["properties"].items())
+        o.properties[key] = value.is_string() ? value.get<std::string>() : value.dump();
+      for (const auto& [first, last] : o.intervals) {
+        boundaries.push_back(first);
+        boundaries.push_back(last + 1);
+      }
+      overrides.push_back(std::move(o));
+    }
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+  // Every node of a segment is covered by the same overrides: resolve each segment once, and
+  // each distinct resulting set once (keyed by its sorted content)
+  std::map<std::vector<std::pair<std::string, std::string>>, size_t> set_index;
+  for (size_t b = 0; b + 1 < boundaries.size(); b++) {
+    const int first = boundaries[b];
+    const int last  = boundaries[b + 1] - 1;
+    PropertySet set = base;
+    for (const auto& o : overrides)
+      for (const auto& [lo, hi] : o.intervals)
+        if (lo <= first && last <= hi)
+          for (const auto& [key, value] : o.properties)
+            set[key] = value;
+    if (set.empty())
+      continue;
+
+    std::vector<std::pair<std::string, std::string>> key(set.begin(), set.end());
+    std::sort(key.begin(), key.end());
+    auto [it, inserted] = set_index.try_emplace(std::move(key), result.sets.size());
+    if (inserted)
+      result.sets.push_back(std::move(set));
+
+    // Merge with the previous segment when it uses the same set
+    if (!result.segments.empty() && result.segments.back().set == it->second && result.segments.back().last == first - 1)
+      result.segments.back().last = last;
+    else
+      result.segments.push_back({first, last, it->second});
+  }
+  return result;
+}
+
+/**
+ * Property sets of the cluster nodes, by node position (see HostNameTable): one entry per property segment,
+ * whatever the number of nodes, and each set stored once per cluster.
+ */
+class NodePropertyTable {
+  struct Range {
+    size_t first; // Positions of the first and last node of the segment
+    size_t last;
+    const PropertySet* set;
+  };
+  std::vector<Range> ranges_;              // Sorted, since clusters get increasing positions
+  std::deque<ClusterProperties> clusters_; // Stable addresses for the ranges
+
+public:
+  /** Properties of a cluster whose node 0 has position @p first */
+  void add_cluster(size_t first, ClusterProperties properties)
+  {
+    if (properties.empty())
+      return;
+    const auto& stored = clusters_.emplace_back(std::move(properties));
+    for (const auto& segment : stored.segments)
+      ranges_.push_back({first + segment.first, first + segment.last, &stored.sets[segment.set]});
+  }
+
+  /** Property set of the node at @p position, or nullptr */
+  const PropertySet* find(size_t position) const
+  {
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), position,
+                               [](size_t pos, const Range& range) { return pos < range.first; });
+    if (it == ranges_.begin() || (--it)->last < position)
+      return nullptr;
+    return it->set;
+  }
+};
+
+/** Nodes of a cluster grouped by their "rack" property, racks in the order of their first node and nodes by index
+ *  within a rack; nodes without a rack form one more group. The identity when no node has a rack. */
+inline std::vector<int> rack_node_order(const ClusterProperties& properties, int count)
+{
+  // Consecutive ranges of nodes with the same rack, as (rack group, first, last)
+  std::vector<std::tuple<size_t, int, int>> ranges;
+  std::unordered_map<std::string, size_t> groups;
+  auto add_range = [&ranges, &groups](const std::string& rack, int first, int last) {
+    if (first > last)
+      return;
+    const size_t group = groups.try_emplace(rack, groups.size()).first->second;
+    ranges.emplace_back(group, first, last);
+  };
+  int next = 0;
+  for (const auto& segment : properties.segments) {
+    add_range("", next, segment.first - 1);
+    auto it = properties.sets[segment.set].find("rack");
+    add_range(it == properties.sets[segment.set].end() ? "" : it->second, segment.first, segment.last);
+    next = segment.last + 1;
+  }
+  add_range("", next, count - 1);
+
+  // Stable, so that ranges keep their node order within a rack
+  std::stable_sort(ranges.begin(), ranges.end(),
+                   [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+  std::vector<int> order;
+  order.reserve(count);
+  for (const auto& [group, first, last] : ranges)
+    for (int i = first; i <= last; i++)
+      order.push_back(i);
+  return order;
+}
+
+#endif
@@ -0,0 +1,362 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "interconnect.hpp"
+#include "route_checker.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+struct CheckZone {
+  std::string name;
+  int parent;
+  int depth;
+  bool has_gateway;
+  bool has_children = false;
+  bool multi_hop    = false; // Floyd or Dijkstra routing: routes chain through sibling zones
+};
+
+struct RouteDecl {
+  int zone;
+  std::string src;
+  std::string dst;
+  std::vector<std::string> links;
+  bool symmetrical;
+};
+
+// Zone tree as built by load_platform(), reduced to what matters for routing
+class ZoneTree {
+  std::vector<CheckZone> zones_;
+  std::unordered_map<std::string, int> by_name_;
+  std::unordered_set<std::string> links_;
+  std::vector<RouteDecl> route_decls_;
+  std::unordered_set<uint64_t> routes_; // (src child zone << 32 | dst child zone), both children of the same zone
+
+  static uint64_t key(int src, int dst) { return (static_cast<uint64_t>(src) << 32) | static_cast<uint32_t>(dst); }
+
+public:
+  std::vector<RouteIssue> issues;
+
+  ZoneTree() { zones_.push_back({"_world_", -1, 0, false}); }
+
+  int add_zone(const std::string& name, int parent, bool has_gateway = true)
+  {
+    int id = static_cast<int>(zones_.size());
+    zones_.push_back({name, parent, zones_[parent].depth + 1, has_gateway});
+    zones_[parent].has_children = true;
+    if (not by_name_.emplace(name, id).second)
+      issues.push_back({"duplicate_zone", zones_[parent].name, name, "", 0, ""});
+    return id;
+  }
+
+  void set_multi_hop(int zone) { zones_[zone].multi_hop = true; }
+
+  void add_links(const json& links_config)
+  {
+    for (const auto& link_cfg : links_config)
+      links_.insert(link_cfg["name"].get<std::string>());
+  }
+
+  void add_routes(int zone, const json& routes_config)
+  {
+    for (const auto& route_cfg : routes_config) {
+      RouteDecl decl{zone, route_cfg["src"], route_cfg["dst"], {}, true};
+      for (const auto& link_name : route_cfg["links"])
+        decl.links.push_back(link_name.get<std::string>());
+      route_decls_.push_back(std::move(decl));
+    }
+  }
+
+  // Routes are resolved once all zones are known, as in the loader
+  void resolve_routes()
+  {
+    for (const auto& decl : route_decls_) {
+      const std::string& zone_name = zones_[decl.zone].name;
+      for (const auto& link_name : decl.links)
+        if (links_.count(link_name) == 0)
+          issues.push_back({"unknown_link", zone_name, link_name, "", 0, decl.src + " -> " + decl.dst});
+
+      auto resolve = [this, &decl, &zone_name](const std::string& endpoint) {
+        auto it = by_name_.find(endpoint);
+        if (it == by_name_.end()) {
+          issues.push_back({"unknown_zone", zone_name, endpoint, "", 0, decl.src + " -> " + decl.dst});
+          return -1;
+        }
+        if (zones_[it->second].parent != decl.zone) {
+          // A Full zone can only route between its own children
+          issues.push_back({"bad_endpoint", zone_name, endpoint, "", 0, decl.src + " -> " + decl.dst});
+          return -1;
+        }
+        return it->second;
+      };
+      int src = resolve(decl.src);
+      int dst = resolve(decl.dst);
+      if (src < 0 || dst < 0)
+        continue;
+      routes_.insert(key(src, dst));
+      if (decl.symmetrical)
+        routes_.insert(key(dst, src));
+    }
+    close_multi_hop_routes();
+  }
+
+  // In Floyd and Dijkstra zones, a child reaches every child reachable through a chain of routes
+  void close_multi_hop_routes()
+  {
+    std::unordered_map<int, std::vector<int>> next;
+    for (uint64_t route : routes_) {
+      int src = static_cast<int>(route >> 32);
+      if (zones_[zones_[src].parent].multi_hop)
+        next[src].push_back(static_cast<int>(static_cast<uint32_t>(route)));
+    }
+    for (const auto& [src, unused] : next) {
+      std::vector<int> stack = {src};
+      std::unordered_set<int> seen = {src};
+      while (not stack.empty()) {
+        int cur = stack.back();
+        stack.pop_back();
+        if (auto it = next.find(cur); it != next.end())
+          for (int dst : it->second)
+            if (seen.insert(dst).second) {
+              stack.push_back(dst);
+              routes_.insert(key(src, dst));
+            }
+      }
+    }
+  }
+
+  const std::vector<CheckZone>& zones() const { return zones_; }
+  bool has_route(int src, int dst) const { return routes_.count(key(src, dst)) != 0; }
+};
+
+// A facility or nested zone, with its children
+void add_zone_config(ZoneTree& tree, const json& zone_config, int parent)
+{
+  int zone = tree.add_zone(zone_config["name"], parent);
+  if (zone_config.value("routing", "Full") != "Full")
+    tree.set_multi_hop(zone);
+  if (zone_config.contains("storage_systems"))
+    for (const auto& storage_cfg : zone_config["storage_systems"])
+      tree.add_zone(storage_cfg["name"], zone);
+  if (zone_config.contains("clusters"))
+    for (const auto& cluster_cfg : zone_config["clusters"])
+      tree.add_zone(cluster_cfg["name"], zone);
+  if (zone_config.contains("graphs"))
+    for (const auto& graph_cfg : zone_config["graphs"])
+      tree.add_zone(graph_cfg["name"], zone, graph_cfg.contains("gateway"));
+  if (zone_config.contains("zones"))
+    for (const auto& child_cfg : zone_config["zones"])
+      add_zone_config(tree, child_cfg, zone);
+  if (zone_config.contains("links"))
+    tree.add_links(zone_config["links"]);
+  if (zone_config.contains("routes"))
+    tree.add_routes(zone, zone_config["routes"]);
+  // Only the connectivity of the interconnect graph matters here; unknown links are reported by resolve_routes()
+  if (zone_config.contains("interconnect"))
+    tree.add_routes(zone, to_routes_config(compute_interconnect_routes(
+                              zone_config, [](const std::string&) { return LinkMetrics{1.0, 0.0}; }, 1)));
+}
+
+void build_zone_tree(ZoneTree& tree, const json& config)
+{
+  for (const auto& dc_config : config["facilities"])
+    add_zone_config(tree, dc_config, 0);
+
+  if (config.contains("storage_systems"))
+    for (const auto& storage_cfg : config["storage_systems"])
+      tree.add_zone(storage_cfg["name"], 0);
+  if (config.contains("links"))
+    tree.add_links(config["links"]);
+  if (config.contains("routes"))
+    tree.add_routes(0, config["routes"]);
+
+  tree.resolve_routes();
+}
+
+// Per-leaf view of the tree: path from the root and shallowest ancestor without a gateway
+struct Leaf {
+  std::vector<int> path;
+  int min_ungated_depth = INT_MAX;
+};
+
+using IssueKey = std::tuple<int, int, int>; // (kind, zone a, zone b)
+struct IssueCount {
+  size_t count = 0;
+  int example_src;
+  int example_dst;
+};
+
+constexpr int MISSING_ROUTE = 0;
+constexpr int NO_GATEWAY    = 1;
+
+void check_pair(const ZoneTree& tree, const std::vector<Leaf>& leaves, int i, int j,
+                std::map<IssueKey, IssueCount>& found)
+{
+  const auto& pi = leaves[i].path;
+  const auto& pj = leaves[j].path;
+  size_t k       = 1;
+  while (pi[k] == pj[k])
+    k++;
+  int lca_depth = static_cast<int>(k) - 1;
+
+  auto record = [&found, i, j](const IssueKey& issue_key) {
+    auto& entry = found[issue_key];
+    if (entry.count++ == 0) {
+      entry.example_src = i;
+      entry.example_dst = j;
+    }
+  };
+
+  // Every zone crossed below the common ancestor must expose a gateway
+  for (const auto& leaf : {&leaves[i], &leaves[j]}) {
+    if (leaf->min_ungated_depth > lca_depth && leaf->min_ungated_depth != INT_MAX) {
+      for (size_t d = k; d < leaf->path.size(); d++)
+        if (not tree.zones()[leaf->path[d]].has_gateway) {
+          record({NO_GATEWAY, leaf->path[d], -1});
+          break;
+        }
+    }
+  }
+  if (not tree.has_route(pi[k], pj[k]))
+    record({MISSING_ROUTE, pi[k], pj[k]});
+}
+
+} // namespace
+
+RouteCheckReport check_routes(const json& config, unsigned threads)
+{
+  auto start = std::chrono::steady_clock::now();
+  RouteCheckReport report;
+
+  ZoneTree tree;
+  build_zone_tree(tree, config);
+  report.issues = std::move(tree.issues);
+
+  const auto& zones = tree.zones();
+  std::vector<Leaf> leaves;
+  std::vector<int> leaf_zone;
+  for (int z = 1; z < static_cast<int>(zones.size()); z++) {
+    if (zones[z].has_children)
+      continue;
+    Leaf leaf;
+    for (int cur = z; cur != -1; cur = zones[cur].parent) {
+      leaf.path.push_back(cur);
+      if (cur != 0 && not zones[cur].has_gateway)
+        leaf.min_ungated_depth = std::min(leaf.min_ungated_depth, zones[cur].depth);
+    }
+    std::reverse(leaf.path.begin(), leaf.path.end());
+    leaves.push_back(std::move(leaf));
+    leaf_zone.push_back(z);
+  }
+  report.leaf_zones = leaves.size();
+
+  if (threads == 0)
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  threads        = std::max(1U, std::min<unsigned>(threads, static_cast<unsigned>(leaves.size())));
+  report.threads = threads;
+
+  // Rows of the pair triangle are handed out dynamically, since they shrink as i grows
+  std::atomic<int> next_row{0};
+  std::mutex merge_mutex;
+  std::map<IssueKey, IssueCount> found;
+  auto worker = [&]() {
+    std::map<IssueKey, IssueCount> local;
+    int n = static_cast<int>(leaves.size());
+    for (int i = next_row++; i < n; i = next_row++) {
+      for (int j = i + 1; j < n; j++) {
+        check_pair(tree, leaves, i, j, local);
+        check_pair(tree, leaves, j, i, local);
+      }
+    }
+    std::lock_guard<std::mutex> lock(merge_mutex);
+    for (const auto& [issue_key, entry] : local) {
+      auto& merged = found[issue_key];
+      if (merged.count == 0) {
+        merged.example_src = entry.example_src;
+        merged.example_dst = entry.example_dst;
+      }
+      merged.count += entry.count;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; t++)
+    pool.emplace_back(worker);
+  worker();
+  for (auto& thread : pool)
+    thread.join();
+
+  report.checked_pairs = leaves.size() * (leaves.size() - (leaves.empty() ? 0 : 1));
+
+  for (const auto& [issue_key, entry] : found) {
+    auto [kind, a, b] = issue_key;
+    RouteIssue issue;
+    issue.affected_pairs = entry.count;
+    issue.example        = zones[leaf_zone[entry.example_src]].name + " -> " + zones[leaf_zone[entry.example_dst]].name;
+    if (kind == MISSING_ROUTE) {
+      issue.kind = "missing_route";
+      issue.zone = zones[zones[a].parent].name;
+      issue.src  = zones[a].name;
+      issue.dst  = zones[b].name;
+    } else {
+      issue.kind = "no_gateway";
+      issue.zone = zones[a].name;
+      issue.src  = zones[a].name;
+    }
+    report.issues.push_back(std::move(issue));
+  }
+
+  report.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return report;
+}
+
+void RouteCheckReport::print(std::ostream& os, size_t max_issues) const
+{
+  os << "Route check: " << leaf_zones << " leaf zones, " << checked_pairs << " routes checked with " << threads
+     << " thread(s) in " << elapsed << "s\n";
+  if (issues.empty()) {
+    os << "  All leaf-zone pairs are routable\n";
+    return;
+  }
+
+  size_t shown = 0;
+  for (const auto& issue : issues) {
+    if (shown++ == max_issues) {
+      os << "  ... and " << issues.size() - max_issues << " more issue(s)\n";
+      break;
+    }
+    os << "  [" << issue.kind << "] in '" << issue.zone << "': ";
+    if (issue.kind == "missing_route")
+      os << "no route from '" << issue.src << "' to '" << issue.dst << "'";
+    else if (issue.kind == "no_gateway")
+      os << "zone '" << issue.src << "' has no gateway but is crossed by inter-zone routes";
+    else if (issue.kind == "duplicate_zone")
+      os << "zone name '" << issue.src << "' is already used";
+    else if (issue.kind == "unknown_link")
+      os << "route uses undeclared link '" << issue.src << "'";
+    else if (issue.kind == "unknown_zone")
+      os << "route references undeclared zone '" << issue.src << "'";
+    else if (issue.kind == "bad_endpoint")
+      os << "route endpoint '" << issue.src << "' is not a direct child of this zone";
+    if (issue.affected_pairs > 0)
+      os << " (" << issue.affected_pairs << " leaf pair(s), e.g. " << issue.example << ")";
+    else if (not issue.example.empty())
+      os << " (route " << issue.example << ")";
+    os << "\n";
+  }
+}
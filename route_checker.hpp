@@ -0,0 +1,53 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file route_checker.hpp
+ * @brief Static route reachability check on a JSON platform configuration.
+ *
+ * The check rebuilds the zone tree described by the configuration (root,
+ * facilities and their nested zones, clusters, storage systems, graph zones)
+ * without SimGrid, then verifies that every ordered pair of leaf zones can be
+ * routed: the two ancestors right below their common ancestor must be joined
+ * by a declared route (or a chain of routes, in Floyd and Dijkstra zones), and
+ * every zone crossed on the way up must have a gateway. Pairs are checked in
+ * parallel.
+ */
+
+#ifndef ROUTE_CHECKER_HPP
+#define ROUTE_CHECKER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+struct RouteIssue {
+  std::string kind;          // missing_route, no_gateway, unknown_zone, unknown_link, bad_endpoint, duplicate_zone
+  std::string zone;          // Zone in which the problem has to be fixed
+  std::string src;           // Route source (or offending name)
+  std::string dst;           // Route destination (empty when not relevant)
+  size_t affected_pairs = 0; // Number of leaf-zone pairs that cannot be routed because of this issue
+  std::string example;       // One of the affected leaf-zone pairs
+};
+
+struct RouteCheckReport {
+  size_t leaf_zones    = 0;
+  size_t checked_pairs = 0;
+  unsigned threads     = 0;
+  double elapsed       = 0.0;
+  std::vector<RouteIssue> issues;
+
+  bool ok() const { return issues.empty(); }
+  void print(std::ostream& os, size_t max_issues = 50) const;
+};
+
+/** Check that all leaf-zone pairs of the platform described by @p config are routable.
+ *  @p threads is the number of worker threads (0 means one per hardware thread). */
+RouteCheckReport check_routes(const nlohmann::json& config, unsigned threads = 0);
+
+#endif
@@ -0,0 +1,152 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#include "synthetic_workloads.hpp"
+
+namespace sg4 = simgrid::s4u;
+using Clock   = std::chrono::steady_clock;
+using Hosts   = std::shared_ptr<const std::vector<sg4::Host*>>;
+
+const std::vector<std::string> synthetic_workloads = {"all-to-all", "scatter-pfs", "local-io"};
+
+WorkloadStats workload_stats;
+
+namespace {
+
+int token; // Payload of all messages: only their size matters
+
+void before_block()
+{
+  workload_stats.last_block = Clock::now();
+}
+
+void completed()
+{
+  workload_stats.events++;
+}
+
+void finished(const std::string& actor)
+{
+  workload_stats.end_times[actor] = sg4::Engine::get_clock();
+}
+
+void all_to_all(const Hosts& hosts, double size)
+{
+  for (size_t i = 0; i < hosts->size(); i++) {
+    std::string name = "a2a-" + std::to_string(i);
+    sg4::Actor::create(name, (*hosts)[i], [hosts, i, size, name]() {
+      std::vector<sg4::CommPtr> sends;
+      for (size_t j = 0; j < hosts->size(); j++)
+        if (j != i)
+          sends.push_back(sg4::Mailbox::by_name("a2a-" + std::to_string(j))->put_async(&token, size));
+      auto* inbox = sg4::Mailbox::by_name(name);
+      for (size_t j = 1; j < hosts->size(); j++) {
+        before_block();
+        inbox->get<int>();
+        completed();
+      }
+      for (auto& send : sends) {
+        before_block();
+        send->wait();
+      }
+      finished(name);
+    });
+  }
+}
+
+void scatter_pfs(const Hosts& hosts, sg4::Host* server, double size)
+{
+  sg4::Actor::create("pfs", server, [server, count = hosts->size(), size]() {
+    auto* inbox = sg4::Mailbox::by_name("pfs");
+    auto* disk  = server->get_disks().front();
+    std::vector<sg4::IoPtr> writes;
+    for (size_t i = 0; i < count; i++) {
+      before_block();
+      inbox->get<int>();
+      completed();
+      writes.push_back(disk->write_async(static_cast<sg_size_t>(size)));
+    }
+    for (auto& write : writes) {
+      before_block();
+      write->wait();
+      completed();
+    }
+    finished("pfs");
+  });
+  for (size_t i = 0; i < hosts->size(); i++) {
+    std::string name = "client-" + std::to_string(i);
+    sg4::Actor::create(name, (*hosts)[i], [size, name]() {
+      before_block();
+      sg4::Mailbox::by_name("pfs")->put(&token, size);
+      finished(name);
+    });
+  }
+}
+
+void local_io(const Hosts& hosts, double size)
+{
+  for (size_t i = 0; i < hosts->size(); i++) {
+    std::string name = "io-" + std::to_string(i);
+    sg4::Actor::create(name, (*hosts)[i], [host = (*hosts)[i], size, name]() {
+      auto* disk = host->get_disks().front();
+      before_block();
+      disk->write(static_cast<sg_size_t>(size));
+      completed();
+      before_block();
+      disk->read(static_cast<sg_size_t>(size));
+      completed();
+      finished(name);
+    });
+  }
+}
+
+} // namespace
+
+bool deploy_workload(const sg4::Engine& engine, const std::string& workload, size_t max_hosts, double size)
+{
+  if (std::find(synthetic_workloads.begin(), synthetic_workloads.end(), workload) == synthetic_workloads.end())
+    throw std::runtime_error("Unknown workload: " + workload);
+
+  // Compute hosts, sampled evenly across clusters, and storage servers
+  std::vector<sg4::Host*> compute;
+  std::vector<sg4::Host*> servers;
+  for (auto* host : engine.get_all_hosts()) {
+    const std::string& name = host->get_name();
+    bool server             = name.size() > 7 && name.compare(name.size() - 7, 7, "_server") == 0;
+    (server ? servers : compute).push_back(host);
+  }
+  auto by_name = [](const sg4::Host* a, const sg4::Host* b) { return a->get_name() < b->get_name(); };
+  std::sort(compute.begin(), compute.end(), by_name);
+  std::sort(servers.begin(), servers.end(), by_name);
+  auto sample = std::make_shared<std::vector<sg4::Host*>>();
+  size_t n    = std::min(max_hosts, compute.size());
+  for (size_t i = 0; i < n; i++)
+    sample->push_back(compute[i * compute.size() / n]);
+
+  auto with_disks = [](const sg4::Host* host) { return not host->get_disks().empty(); };
+  if (workload == "all-to-all") {
+    if (sample->size() < 2)
+      return false;
+    all_to_all(sample, size);
+  } else if (workload == "scatter-pfs") {
+    auto server = std::find_if(servers.begin(), servers.end(), with_disks);
+    if (server == servers.end() || sample->empty())
+      return false;
+    scatter_pfs(sample, *server, size);
+  } else {
+    if (sample->empty() || not std::all_of(sample->begin(), sample->end(), with_disks))
+      return false;
+    local_io(sample, size);
+  }
+
+  sg4::Engine::on_time_advance_cb([](double) {
+    workload_stats.solve_seconds += std::chrono::duration<double>(Clock::now() - workload_stats.last_block).count();
+  });
+  return true;
+}
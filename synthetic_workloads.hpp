@@ -0,0 +1,50 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file synthetic_workloads.hpp
+ * @brief Synthetic workloads run on loaded platforms by bench_simulation and platform_autotune.
+ *
+ * Workloads run on a sample of the compute hosts (hosts not named "*_server"),
+ * taken evenly across the clusters in name order, so that the same hosts are
+ * used whatever the topology encoding of the platform:
+ *   - all-to-all  : every host sends a message to every other one
+ *   - scatter-pfs : every host sends a message to the first storage server
+ *                   with a disk, which writes it
+ *   - local-io    : every host writes then reads its first disk
+ * Completed communications and I/Os are counted as events, and the end time of
+ * every actor is recorded so that runs on different encodings can be compared.
+ */
+
+#ifndef SYNTHETIC_WORKLOADS_HPP
+#define SYNTHETIC_WORKLOADS_HPP
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+extern const std::vector<std::string> synthetic_workloads;
+
+struct WorkloadStats {
+  size_t events        = 0;
+  double solve_seconds = 0.0; // Wall time from the last actor blocking to the next clock advance
+  std::map<std::string, double> end_times; // Simulated end time of each actor
+  std::chrono::steady_clock::time_point last_block;
+};
+
+extern WorkloadStats workload_stats;
+
+/**
+ * Create the actors of @p workload on the hosts of @p engine, using at most
+ * @p max_hosts compute hosts and messages or I/Os of @p size bytes. Returns
+ * false, with no actor created, when the platform lacks what the workload
+ * needs (hosts, a storage server, node disks); throws for unknown workloads.
+ */
+bool deploy_workload(const simgrid::s4u::Engine& engine, const std::string& workload, size_t max_hosts, double size);
+
+#endif
@@ -16,6 +16,8 @@
 #include <fsmod/FileSystem.hpp>
 #include <simgrid/s4u.hpp>
 
+#include "json_platform_loader.hpp"
+
 namespace sg4  = simgrid::s4u;
 namespace sgfs = simgrid::fsmod;
 
@@ -76,6 +78,16 @@ void run_json_test(int argc, char** argv) {
   std::cout << fp.serialize();
 }
 
+// Same JSON loader, through begin_load() and commit(), with the configuration planned while the engine starts
+void run_async_test(int argc, char** argv) {
+  PlatformLoad load = begin_load();
+  sg4::Engine e(&argc, argv);
+  load.commit(e);
+  PlatformFingerprint fp;
+  fp.collect(e);
+  std::cout << fp.serialize();
+}
+
 void run_cpp_test(int argc, char** argv) {
   sg4::Engine e(&argc, argv);
   load_platform_cpp(e);
@@ -96,7 +108,13 @@ int main(int argc, char** argv)
       run_cpp_test(argc - 1, argv + 1);
       return 0;
     }
+    if (strcmp(argv[1], "--async") == 0) {
+      run_async_test(argc - 1, argv + 1);
+      return 0;
+    }
   }
+  // With --async-loader, the JSON side uses the asynchronous API
+  const bool async = argc >= 2 && strcmp(argv[1], "--async-loader") == 0;
 
   // Main comparison mode: run both as subprocesses
   std::cout << "=== Platform Comparison Test: cluster25 ===\n\n";
@@ -106,7 +124,7 @@ int main(int argc, char** argv)
 
   // Run JSON version
   std::cout << "Loading JSON-generated platform...\n";
-  FILE* json_pipe = popen((exe_path + " --json 2>/dev/null").c_str(), "r");
+  FILE* json_pipe = popen((exe_path + (async ? " --async" : " --json") + " 2>/dev/null").c_str(), "r");
   if (!json_pipe) {
     std::cerr << "Failed to run JSON platform test\n";
     return 1;
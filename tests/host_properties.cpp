@@ -0,0 +1,136 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+// Host property modes: the configuration loaded with "host_properties": "copy" (its default) and "shared" gives
+// the same zones, hosts and host_properties(). Copied sets are also seen by Host::get_property(), shared ones are
+// not, and nodes of one property segment share one set object.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+#include <simgrid/s4u.hpp>
+
+#include "json_platform_loader.hpp"
+
+namespace sg4 = simgrid::s4u;
+using json    = nlohmann::json;
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what)
+{
+  if (!condition) {
+    std::cout << "FAIL: " << what << "\n";
+    failures++;
+  }
+}
+
+const std::unordered_map<std::string, std::string>* properties_of(const std::string& host_name)
+{
+  return host_properties(sg4::Host::by_name(host_name));
+}
+
+// Loads the platform and prints its zones and hosts, then the host_properties() of every host
+int dump(int argc, char** argv, bool shared)
+{
+  sg4::Engine e(&argc, argv);
+  load_platform(e);
+
+  std::map<std::string, int> zone_hosts;
+  std::map<std::string, std::string> host_lines;
+  for (auto* host : e.get_all_hosts()) {
+    zone_hosts[host->get_englobing_zone()->get_name()]++;
+    std::ostringstream line;
+    line << "H:" << host->get_name() << ":" << host->get_speed() << ":" << host->get_core_count();
+    if (const auto* set = host_properties(host)) {
+      const std::map<std::string, std::string> sorted(set->begin(), set->end());
+      for (const auto& [key, value] : sorted) {
+        line << ":" << key << "=" << value;
+        const char* copied = host->get_property(key);
+        if (shared) {
+          expect(copied == nullptr, host->get_name() + " has a copy of property " + key);
+        } else {
+          expect(copied != nullptr && value == copied, host->get_name() + " has no copy of property " + key);
+        }
+      }
+    }
+    host_lines[host->get_name()] = line.str();
+  }
+  for (const auto& [zone, count] : zone_hosts) {
+    std::cout << "Z:" << zone << ":" << count << "\n";
+  }
+  for (const auto& [name, line] : host_lines) {
+    std::cout << line << "\n";
+  }
+
+  // Segments of cpu: 0-3 (gpu queue), 4-5 (base set), 6-7 (rack r2); plain has no properties
+  expect(properties_of("cpu-0") != nullptr && properties_of("cpu-0") == properties_of("cpu-3"),
+         "cpu-0 and cpu-3 do not share their property set");
+  expect(properties_of("cpu-4") != nullptr && properties_of("cpu-4") == properties_of("cpu-5"),
+         "cpu-4 and cpu-5 do not share their property set");
+  expect(properties_of("cpu-0") != properties_of("cpu-4") && properties_of("cpu-4") != properties_of("cpu-6"),
+         "different segments of cpu share a property set");
+  expect(properties_of("plain-0") == nullptr, "plain-0 has properties");
+  return failures == 0 ? 0 : 1;
+}
+
+// Standard output of @p command, or an empty string when it fails
+std::string run(const std::string& command)
+{
+  FILE* pipe = popen((command + " 2>/dev/null").c_str(), "r");
+  if (!pipe) {
+    return "";
+  }
+  std::string output;
+  char buffer[256];
+  while (fgets(buffer, sizeof(buffer), pipe)) {
+    output += buffer;
+  }
+  if (pclose(pipe) != 0) {
+    std::cerr << command << " failed:\n" << output;
+    return "";
+  }
+  return output;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc >= 3 && strcmp(argv[1], "--dump") == 0) {
+    return dump(argc - 2, argv + 2, strcmp(argv[2], "shared") == 0);
+  }
+
+  const char* config_path = std::getenv("PLATFORM_CONFIG");
+  if (config_path == nullptr) {
+    std::cerr << "PLATFORM_CONFIG is not set\n";
+    return 1;
+  }
+  std::ifstream config_file(config_path);
+  json shared_config               = json::parse(config_file);
+  shared_config["host_properties"] = "shared";
+  const std::string shared_path    = "host_properties_shared.json";
+  std::ofstream(shared_path) << shared_config.dump(2);
+
+  const std::string exe_path      = argv[0];
+  const std::string copy_output   = run(exe_path + " --dump copy");
+  const std::string shared_output = run("PLATFORM_CONFIG=" + shared_path + " " + exe_path + " --dump shared");
+  if (copy_output.empty() || shared_output.empty()) {
+    return 1;
+  }
+  if (copy_output != shared_output) {
+    std::cout << "Result: FAIL - Property modes differ\n\n";
+    std::cout << "copy:\n" << copy_output << "\nshared:\n" << shared_output << "\n";
+    return 1;
+  }
+  std::cout << "Result: PASS - Property modes are equivalent\n";
+  return 0;
+}
@@ -0,0 +1,64 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+// lookup_host() against Engine::host_by_name_or_null() on cluster25: every host, found by prefix, index and
+// suffix (two clusters share the "node-" prefix) or through the hash table (storage servers), and names
+// that must not resolve
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+#include "json_platform_loader.hpp"
+
+namespace sg4 = simgrid::s4u;
+
+int main(int argc, char** argv)
+{
+  sg4::Engine e(&argc, argv);
+  load_platform(e);
+
+  int failures = 0;
+  auto check   = [&e, &failures](const std::string& name) {
+    const sg4::Host* expected = e.host_by_name_or_null(name);
+    const sg4::Host* found    = lookup_host(name);
+    if (found != expected) {
+      std::cerr << "FAIL: '" << name << "' resolves to " << (found ? found->get_name() : "nothing") << " instead of "
+                << (expected ? expected->get_name() : "nothing") << "\n";
+      failures++;
+    }
+  };
+
+  const std::vector<sg4::Host*> hosts = e.get_all_hosts();
+  for (const auto* host : hosts) {
+    check(host->get_name());
+  }
+
+  const std::vector<std::string> unknown = {
+      "",                              // Empty
+      "node-256.pub",                  // Out of range: pub_cluster has 256 nodes
+      "node-128.sub",                  // Out of range: sub_cluster has 128 nodes, though pub_cluster has a node 128
+      "node-99999999999999999999.pub", // Index overflow
+      "node-007.pub",                  // Zero-padded
+      "node-00.sub",                   // Zero-padded zero
+      "node-.pub",                     // No index
+      "node-12",                       // No suffix
+      "node-12.pu",                    // Suffix of no cluster
+      "node-12.pubx",                  // Suffix with trailing text
+      "nodes-12.pub",                  // Prefix of no cluster
+      "node-1-2.pub",                  // Two digit runs, neither one an index
+      "pfs_serve",                     // Prefix of a hash table entry
+      "pfs_server0",                   // Hash table entry with trailing digits
+  };
+  for (const auto& name : unknown) {
+    check(name);
+  }
+
+  std::cout << hosts.size() << " hosts, " << unknown.size() << " unknown names: " << (failures == 0 ? "PASS" : "FAIL")
+            << "\n";
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+// Rail selection of multi-rail clusters: the route between every pair of nodes of a hash and a parity cluster
+// goes through the source's up link, the backbone and the destination's down link of the rail given by rail_of().
+// Routes between the two clusters leave and enter each one on the rail of the node and its gateway (node count).
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+#include "cluster_builder.hpp"
+#include "json_platform_loader.hpp"
+
+namespace sg4 = simgrid::s4u;
+
+// Names of the links of the route from @p src to @p dst
+std::vector<std::string> route_names(const std::string& src, const std::string& dst)
+{
+  std::vector<sg4::Link*> links;
+  double latency = 0;
+  sg4::Host::by_name(src)->route_to(sg4::Host::by_name(dst), links, &latency);
+  std::vector<std::string> names;
+  for (const auto* link : links) {
+    names.push_back(link->get_name());
+  }
+  return names;
+}
+
+// Number of pairs of nodes of the cluster whose route is not the expected one
+int check_cluster(const std::string& name, int count, size_t rails, RailPolicy policy)
+{
+  int failures = 0;
+  for (int src = 0; src < count; src++) {
+    for (int dst = 0; dst < count; dst++) {
+      if (dst == src) {
+        continue;
+      }
+      const std::string src_name = name + "-" + std::to_string(src);
+      const std::string dst_name = name + "-" + std::to_string(dst);
+      const std::string rail     = std::to_string(rail_of(policy, rails, src, dst));
+      const std::vector<std::string> expected = {src_name + "_rail" + rail + "_LinkUP",
+                                                 name + "_rail" + rail + "_backbone",
+                                                 dst_name + "_rail" + rail + "_LinkDOWN"};
+
+      const std::vector<std::string> route = route_names(src_name, dst_name);
+      if (route != expected) {
+        std::cerr << "FAIL: " << src_name << " -> " << dst_name << " does not use rail " << rail << ":";
+        for (const auto& link : route) {
+          std::cerr << " " << link;
+        }
+        std::cerr << "\n";
+        failures++;
+      }
+    }
+  }
+  return failures;
+}
+
+// Number of pairs of a node of h and a node of p whose routes, in either direction, are not on the expected rails
+int check_external(int count)
+{
+  int failures = 0;
+  for (int i = 0; i < count; i++) {
+    for (int j = 0; j < count; j++) {
+      const std::string h_node = "h-" + std::to_string(i);
+      const std::string p_node = "p-" + std::to_string(j);
+      const std::string h_rail = std::to_string(rail_of(RailPolicy::HASH, 3, i, count));
+      const std::string p_rail = std::to_string(rail_of(RailPolicy::PARITY, 2, j, count));
+      const std::vector<std::string> forward = {h_node + "_rail" + h_rail + "_LinkUP", "h_rail" + h_rail + "_backbone",
+                                                "h-p", "p_rail" + p_rail + "_backbone",
+                                                p_node + "_rail" + p_rail + "_LinkDOWN"};
+      const std::vector<std::string> backward = {p_node + "_rail" + p_rail + "_LinkUP", "p_rail" + p_rail + "_backbone",
+                                                 "h-p", "h_rail" + h_rail + "_backbone",
+                                                 h_node + "_rail" + h_rail + "_LinkDOWN"};
+      if (route_names(h_node, p_node) != forward || route_names(p_node, h_node) != backward) {
+        std::cerr << "FAIL: " << h_node << " <-> " << p_node << " does not use rails " << h_rail << " and " << p_rail
+                  << "\n";
+        failures++;
+      }
+    }
+  }
+  return failures;
+}
+
+int main(int argc, char** argv)
+{
+  sg4::Engine e(&argc, argv);
+  load_platform(e);
+
+  // Pairs of the hash cluster must spread over all its rails, or the test would not tell policies apart
+  std::vector<bool> used(3, false);
+  for (int src = 0; src < 6; src++) {
+    for (int dst = src + 1; dst < 6; dst++) {
+      used[rail_of(RailPolicy::HASH, 3, src, dst)] = true;
+    }
+  }
+  if (used != std::vector<bool>(3, true)) {
+    std::cerr << "FAIL: the hash policy leaves a rail unused\n";
+    return 1;
+  }
+
+  const int failures = check_cluster("h", 6, 3, RailPolicy::HASH) + check_cluster("p", 6, 2, RailPolicy::PARITY) +
+                       check_external(6);
+  std::cout << (failures == 0 ? "PASS" : "FAIL") << "\n";
+  return failures == 0 ? 0 : 1;
+}
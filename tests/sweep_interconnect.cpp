@@ -0,0 +1,100 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+// Parameter sweep over a facility routed by an interconnect graph: points may change its links only when the
+// routes computed from the new values are the ones of the built platform
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <simgrid/s4u.hpp>
+
+#include "json_platform_loader.hpp"
+
+namespace sg4 = simgrid::s4u;
+using json    = nlohmann::json;
+
+// Copy of the loaded configuration with @p field of link @p link set to @p value, written to @p path
+std::string write_point(const json& base, const std::string& path, const std::string& link, const std::string& field,
+                        const std::string& value)
+{
+  json point = base;
+  for (auto& link_cfg : point["facilities"][0]["links"]) {
+    if (link_cfg["name"] == link) {
+      link_cfg[field] = value;
+    }
+  }
+  std::ofstream(path) << point.dump(2);
+  return path;
+}
+
+// Names of the links from the first node of a to the first node of b
+std::vector<std::string> route_a_to_b()
+{
+  std::vector<sg4::Link*> links;
+  double latency = 0;
+  sg4::Host::by_name("a-0")->route_to(sg4::Host::by_name("b-0"), links, &latency);
+  std::vector<std::string> names;
+  for (const auto* link : links) {
+    names.push_back(link->get_name());
+  }
+  return names;
+}
+
+void expect(bool condition, const std::string& what)
+{
+  if (!condition) {
+    throw std::runtime_error(what);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  sg4::Engine e(&argc, argv);
+  const char* config_path = std::getenv("PLATFORM_CONFIG");
+  if (config_path == nullptr) {
+    std::cerr << "PLATFORM_CONFIG is not set\n";
+    return 1;
+  }
+  std::ifstream config_file(config_path);
+  const json base = json::parse(config_file);
+
+  // A lower latency on the direct link makes it the best path: rejected before building anything
+  const std::string reroute = write_point(base, "sweep_reroute.json", "direct", "latency", "1us");
+  try {
+    run_parameter_sweep(e, {reroute}, [](size_t) {});
+    std::cerr << "FAIL: a point changing the interconnect routes was accepted\n";
+    return 1;
+  } catch (const std::runtime_error& error) {
+    std::cout << "Rejected: " << error.what() << "\n";
+  }
+
+  // Same routes: the metric ignores bandwidths, and 5us direct is still slower than 2us through the core
+  const std::vector<std::string> points = {
+      write_point(base, "sweep_bandwidth.json", "a-core", "bandwidth", "5GBps"),
+      write_point(base, "sweep_latency.json", "direct", "latency", "5us")};
+  const std::vector<int> statuses = run_parameter_sweep(e, points, [](size_t point) {
+    const auto route = route_a_to_b();
+    expect(std::find(route.begin(), route.end(), "a-core") != route.end() &&
+               std::find(route.begin(), route.end(), "direct") == route.end(),
+           "route from a to b does not go through the core");
+    if (point == 0) {
+      expect(sg4::Link::by_name("a-core")->get_bandwidth() == 5e9, "a-core bandwidth not set");
+    } else {
+      expect(sg4::Link::by_name("direct")->get_latency() == 5e-6, "direct latency not set");
+    }
+  });
+
+  for (size_t i = 0; i < statuses.size(); i++) {
+    std::cout << points[i] << ": " << (statuses[i] == 0 ? "PASS" : "FAIL") << "\n";
+  }
+  return std::all_of(statuses.begin(), statuses.end(), [](int status) { return status == 0; }) ? 0 : 1;
+}
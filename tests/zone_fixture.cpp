@@ -0,0 +1,88 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+// Zone tree and routes of a small fixture, compared with an expected listing.
+//
+// Usage: test_zone_fixture <expected file>, with PLATFORM_CONFIG set. The expected file lists the zones under
+// the root, indented by depth, with the number of hosts directly in each one, followed by routes given as
+// "<src host> -> <dst host>: <links>"; the source and destination of these lines are the routes to resolve.
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <simgrid/s4u.hpp>
+
+#include "json_platform_loader.hpp"
+
+namespace sg4 = simgrid::s4u;
+
+void print_zone(std::ostream& out, const sg4::NetZone* zone, int depth)
+{
+  size_t hosts = 0;
+  for (const auto* host : zone->get_all_hosts()) {
+    if (host->get_englobing_zone() == zone) {
+      hosts++;
+    }
+  }
+  out << std::string(2 * depth, ' ') << zone->get_name() << " (" << hosts << " hosts)\n";
+  for (const auto* child : zone->get_children()) {
+    print_zone(out, child, depth + 1);
+  }
+}
+
+void print_route(std::ostream& out, const std::string& src, const std::string& dst)
+{
+  std::vector<sg4::Link*> links;
+  double latency = 0;
+  sg4::Host::by_name(src)->route_to(sg4::Host::by_name(dst), links, &latency);
+  out << src << " -> " << dst << ":";
+  for (const auto* link : links) {
+    out << " " << link->get_name();
+  }
+  out << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  sg4::Engine e(&argc, argv);
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <expected file>\n";
+    return 1;
+  }
+  std::ifstream expected_file(argv[1]);
+  if (!expected_file.is_open()) {
+    std::cerr << "Cannot open " << argv[1] << "\n";
+    return 1;
+  }
+  std::stringstream expected;
+  expected << expected_file.rdbuf();
+
+  load_platform(e);
+  std::ostringstream actual;
+  for (const auto* zone : e.get_netzone_root()->get_children()) {
+    print_zone(actual, zone, 0);
+  }
+  std::istringstream lines(expected.str());
+  std::string line;
+  while (std::getline(lines, line)) {
+    const size_t arrow = line.find(" -> ");
+    const size_t colon = line.find(':');
+    if (arrow != std::string::npos && colon != std::string::npos) {
+      print_route(actual, line.substr(0, arrow), line.substr(arrow + 4, colon - arrow - 4));
+    }
+  }
+
+  if (actual.str() != expected.str()) {
+    std::cout << "Result: FAIL - " << argv[1] << " differs\n\nExpected:\n"
+              << expected.str() << "\nActual:\n"
+              << actual.str();
+    return 1;
+  }
+  std::cout << "Result: PASS\n" << actual.str();
+  return 0;
+}
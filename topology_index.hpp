@@ -0,0 +1,368 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file topology_index.hpp
+ * @brief Binary topology index of a platform, and its header-only reader.
+ *
+ * The loader (top-level "topology_index" key) and the platform_index tool
+ * write a file that other processes can map and query in place, without
+ * SimGrid or JSON parsing. Lookups and record accessors return views into the
+ * mapping and do not allocate; only zone_path() builds a std::string:
+ *
+ *     IndexHeader                       magic, version, byte order, size, section table
+ *     strings    char[]                 all names, referenced by IndexString
+ *     zones      IndexZone[]            zone tree (parent links), world zone first
+ *     clusters   IndexCluster[]         node ranges and per-node link characteristics
+ *     hosts      IndexHost[]            cluster nodes are consecutive, in node order
+ *     disks      IndexDisk[]            disks and their storage, consecutive per host
+ *     links      IndexLink[]            declared links, cluster backbones, graph links
+ *     host_order uint32_t[]             host ids sorted by name, for lookups
+ *     vm_pools   IndexVmPool[]          VM pools of clusters, with their VM range
+ *     vms        IndexVm[]              VMs, consecutive per pool, node after node
+ *     vm_order   uint32_t[]             VM ids sorted by name, for lookups
+ *     locality   uint32_t[]             host ids in locality order, as hosts_by_locality()
+ *
+ * Sections are 8-byte aligned, integers are little endian and speeds,
+ * bandwidths and latencies are in flop/s, bytes/s and seconds. Per-node
+ * cluster links are described by their cluster rather than listed.
+ * Readers accept files of the same INDEX_VERSION only.
+ *
+ *     TopologyIndex index("platform.idx");
+ *     if (const IndexHost* host = index.find_host("node-42.pub"))
+ *       std::cout << index.zone_path(host->zone) << " " << host->speed << "\n";
+ */
+
+#ifndef TOPOLOGY_INDEX_HPP
+#define TOPOLOGY_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr char INDEX_MAGIC[8]       = {'P', 'L', 'T', 'I', 'N', 'D', 'E', 'X'};
+constexpr uint32_t INDEX_VERSION    = 3;
+constexpr uint32_t INDEX_BYTE_ORDER = 0x01020304;
+constexpr uint32_t INDEX_NONE       = 0xffffffff; // Absent zone, cluster or node index
+
+enum IndexSection : uint32_t {
+  SECTION_STRINGS,
+  SECTION_ZONES,
+  SECTION_CLUSTERS,
+  SECTION_HOSTS,
+  SECTION_DISKS,
+  SECTION_LINKS,
+  SECTION_HOST_ORDER,
+  SECTION_VM_POOLS,
+  SECTION_VMS,
+  SECTION_VM_ORDER,
+  SECTION_LOCALITY_ORDER,
+  SECTION_COUNT
+};
+
+enum class ZoneKind : uint32_t { WORLD, ZONE, CLUSTER, STORAGE_SYSTEM, GRAPH };
+enum class ZoneRouting : uint32_t { FULL, FLOYD, DIJKSTRA, STAR };
+
+struct IndexString {
+  uint32_t offset; // In the string section
+  uint32_t length;
+};
+
+struct IndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t file_size;
+  struct {
+    uint64_t offset; // From the start of the file
+    uint64_t count;  // Records (bytes for the string section)
+  } sections[SECTION_COUNT];
+};
+
+struct IndexZone {
+  IndexString name;
+  uint32_t parent; // INDEX_NONE for the world zone
+  ZoneKind kind;
+  ZoneRouting routing;
+  uint32_t first_host; // Hosts created directly in this zone
+  uint32_t host_count;
+  uint32_t reserved;
+};
+
+struct IndexCluster {
+  IndexString name;
+  IndexString prefix;
+  IndexString suffix;
+  uint32_t zone;
+  uint32_t first_host; // Node i is host first_host + i
+  uint32_t count;
+  uint32_t cores;
+  uint32_t rails; // Links and backbones below are those of rail 0 of multi-rail clusters
+  uint32_t reserved;
+  double speed;
+  double link_bandwidth; // Private link of each node, in each direction
+  double link_latency;
+  double backbone_bandwidth;
+  double backbone_latency;
+};
+
+struct IndexHost {
+  IndexString name;
+  uint32_t zone;
+  uint32_t cluster;    // INDEX_NONE outside clusters
+  uint32_t node_index; // Index in the cluster, INDEX_NONE outside clusters
+  uint32_t cores;
+  uint32_t first_disk;
+  uint32_t disk_count;
+  double speed;
+};
+
+struct IndexDisk {
+  IndexString name;
+  IndexString storage; // FSMod storage built on the disk (empty when there is none)
+  uint32_t host;
+  uint32_t reserved;
+  double read_bandwidth;
+  double write_bandwidth;
+};
+
+struct IndexLink {
+  IndexString name;
+  uint32_t zone;
+  uint32_t fatpipe; // 1 for FATPIPE links, 0 for SHARED ones
+  double bandwidth;
+  double latency;
+};
+
+struct IndexVmPool {
+  IndexString name;
+  uint32_t cluster;
+  uint32_t first_vm; // VM v of node i is VM first_vm + i * per_host + v
+  uint32_t per_host;
+  uint32_t cores;
+  uint64_t ramsize; // Bytes, 0 when not given
+};
+
+struct IndexVm {
+  IndexString name;
+  uint32_t host; // Physical host
+  uint32_t pool;
+  uint32_t slot; // Index of the VM on its host, in its pool
+  uint32_t reserved;
+};
+
+static_assert(sizeof(IndexZone) == 32 && sizeof(IndexCluster) == 88 && sizeof(IndexHost) == 40 &&
+                  sizeof(IndexDisk) == 40 && sizeof(IndexLink) == 32 && sizeof(IndexVmPool) == 32 &&
+                  sizeof(IndexVm) == 24,
+              "Index records must keep their on-disk layout");
+
+/** Contiguous records of one section */
+template <typename T> class IndexRecords {
+  const T* data_ = nullptr;
+  size_t size_   = 0;
+
+public:
+  IndexRecords() = default;
+  IndexRecords(const T* data, size_t size) : data_(data), size_(size) {}
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+  size_t size() const { return size_; }
+  const T& operator[](size_t i) const { return data_[i]; }
+};
+
+/** Read-only view of a topology index file, mapped for the lifetime of the object */
+class TopologyIndex {
+  void* data_  = nullptr;
+  size_t size_ = 0;
+
+  const char* strings_   = nullptr;
+  uint64_t strings_size_ = 0;
+  IndexRecords<IndexZone> zones_;
+  IndexRecords<IndexCluster> clusters_;
+  IndexRecords<IndexHost> hosts_;
+  IndexRecords<IndexDisk> disks_;
+  IndexRecords<IndexLink> links_;
+  IndexRecords<uint32_t> host_order_;
+  IndexRecords<IndexVmPool> vm_pools_;
+  IndexRecords<IndexVm> vms_;
+  IndexRecords<uint32_t> vm_order_;
+  IndexRecords<uint32_t> locality_order_;
+
+  [[noreturn]] static void fail(const std::string& path, const std::string& what)
+  {
+    throw std::runtime_error("Invalid topology index " + path + ": " + what);
+  }
+
+  template <typename T> IndexRecords<T> section(const IndexHeader& header, IndexSection id, const std::string& path)
+  {
+    const auto& s = header.sections[id];
+    if (s.offset % alignof(T) != 0 || s.offset > size_ || s.count > (size_ - s.offset) / sizeof(T))
+      fail(path, "section " + std::to_string(id) + " out of bounds");
+    return {reinterpret_cast<const T*>(static_cast<const char*>(data_) + s.offset), static_cast<size_t>(s.count)};
+  }
+
+public:
+  explicit TopologyIndex(const std::string& path)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Cannot open topology index: " + path);
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+      size_ = static_cast<size_t>(st.st_size);
+    if (size_ >= sizeof(IndexHeader))
+      data_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data_ == nullptr || data_ == MAP_FAILED) {
+      data_ = nullptr;
+      fail(path, "too small or cannot be mapped");
+    }
+
+    try {
+      IndexHeader header;
+      std::memcpy(&header, data_, sizeof(header));
+      if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+        fail(path, "bad magic");
+      if (header.byte_order != INDEX_BYTE_ORDER)
+        fail(path, "written on a machine of different byte order");
+      if (header.version != INDEX_VERSION)
+        fail(path, "version " + std::to_string(header.version) + " (expected " + std::to_string(INDEX_VERSION) + ")");
+      if (header.file_size != size_)
+        fail(path, "truncated");
+
+      auto strings    = section<char>(header, SECTION_STRINGS, path);
+      strings_        = strings.begin();
+      strings_size_   = strings.size();
+      zones_          = section<IndexZone>(header, SECTION_ZONES, path);
+      clusters_       = section<IndexCluster>(header, SECTION_CLUSTERS, path);
+      hosts_          = section<IndexHost>(header, SECTION_HOSTS, path);
+      disks_          = section<IndexDisk>(header, SECTION_DISKS, path);
+      links_          = section<IndexLink>(header, SECTION_LINKS, path);
+      host_order_     = section<uint32_t>(header, SECTION_HOST_ORDER, path);
+      vm_pools_       = section<IndexVmPool>(header, SECTION_VM_POOLS, path);
+      vms_            = section<IndexVm>(header, SECTION_VMS, path);
+      vm_order_       = section<uint32_t>(header, SECTION_VM_ORDER, path);
+      locality_order_ = section<uint32_t>(header, SECTION_LOCALITY_ORDER, path);
+      if (host_order_.size() != hosts_.size())
+        fail(path, "host order does not cover the hosts");
+      if (locality_order_.size() != hosts_.size())
+        fail(path, "locality order does not cover the hosts");
+      if (vm_order_.size() != vms_.size())
+        fail(path, "VM order does not cover the VMs");
+    } catch (...) {
+      munmap(data_, size_);
+      throw;
+    }
+  }
+  TopologyIndex(const TopologyIndex&)            = delete;
+  TopologyIndex& operator=(const TopologyIndex&) = delete;
+  ~TopologyIndex() { munmap(data_, size_); }
+
+  IndexRecords<IndexZone> zones() const { return zones_; }
+  IndexRecords<IndexCluster> clusters() const { return clusters_; }
+  IndexRecords<IndexHost> hosts() const { return hosts_; }
+  IndexRecords<IndexDisk> disks() const { return disks_; }
+  IndexRecords<IndexLink> links() const { return links_; }
+  IndexRecords<IndexVmPool> vm_pools() const { return vm_pools_; }
+  IndexRecords<IndexVm> vms() const { return vms_; }
+  /** Host ids grouped by zone, then by rack within clusters (see hosts_by_locality() in the loader) */
+  IndexRecords<uint32_t> locality_order() const { return locality_order_; }
+
+  std::string_view str(IndexString s) const
+  {
+    if (s.offset > strings_size_ || s.length > strings_size_ - s.offset)
+      return {};
+    return {strings_ + s.offset, s.length};
+  }
+
+  /** Host by name, in O(log hosts) */
+  const IndexHost* find_host(std::string_view name) const
+  {
+    auto it = std::lower_bound(host_order_.begin(), host_order_.end(), name,
+                               [this](uint32_t host, std::string_view n) { return str(hosts_[host].name) < n; });
+    if (it == host_order_.end() || str(hosts_[*it].name) != name)
+      return nullptr;
+    return &hosts_[*it];
+  }
+
+  /** VM by name, in O(log VMs) */
+  const IndexVm* find_vm(std::string_view name) const
+  {
+    auto it = std::lower_bound(vm_order_.begin(), vm_order_.end(), name,
+                               [this](uint32_t vm, std::string_view n) { return str(vms_[vm].name) < n; });
+    if (it == vm_order_.end() || str(vms_[*it].name) != name)
+      return nullptr;
+    return &vms_[*it];
+  }
+
+  /** VM pool @p name of @p cluster, or nullptr */
+  const IndexVmPool* find_vm_pool(const IndexCluster& cluster, std::string_view name) const
+  {
+    const auto cluster_id = static_cast<uint32_t>(&cluster - clusters_.begin());
+    for (const auto& pool : vm_pools_)
+      if (pool.cluster == cluster_id && str(pool.name) == name)
+        return &pool;
+    return nullptr;
+  }
+
+  const IndexCluster* find_cluster(std::string_view name) const
+  {
+    for (const auto& cluster : clusters_)
+      if (str(cluster.name) == name)
+        return &cluster;
+    return nullptr;
+  }
+
+  const IndexZone* find_zone(std::string_view name) const
+  {
+    for (const auto& zone : zones_)
+      if (str(zone.name) == name)
+        return &zone;
+    return nullptr;
+  }
+
+  /** Node @p index of @p cluster, or nullptr when out of range */
+  const IndexHost* cluster_node(const IndexCluster& cluster, uint32_t index) const
+  {
+    return index < cluster.count ? &hosts_[cluster.first_host + index] : nullptr;
+  }
+
+  /** VM @p slot of node @p index of the cluster of @p pool, or nullptr when out of range */
+  const IndexVm* pool_vm(const IndexVmPool& pool, uint32_t index, uint32_t slot) const
+  {
+    if (slot >= pool.per_host || index >= clusters_[pool.cluster].count)
+      return nullptr;
+    return &vms_[pool.first_vm + static_cast<size_t>(index) * pool.per_host + slot];
+  }
+
+  IndexRecords<IndexDisk> host_disks(const IndexHost& host) const
+  {
+    return {disks_.begin() + host.first_disk, host.disk_count};
+  }
+
+  /** Hosts created directly in @p zone, in creation order */
+  IndexRecords<IndexHost> zone_hosts(const IndexZone& zone) const
+  {
+    return {hosts_.begin() + zone.first_host, zone.host_count};
+  }
+
+  /** Zone names from the child of the world zone down to @p zone, separated by '/'. Allocates the string. */
+  std::string zone_path(uint32_t zone) const
+  {
+    std::string path;
+    for (; zone != INDEX_NONE && zones_[zone].parent != INDEX_NONE; zone = zones_[zone].parent)
+      path.insert(0, "/" + std::string(str(zones_[zone].name)));
+    return path.empty() ? "/" : path;
+  }
+};
+
+#endif
@@ -0,0 +1,157 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file vm_pools.hpp
+ * @brief Virtual machine pools declared on clusters.
+ *
+ * A cluster may carry a list of "vm_pools", each creating the same number of
+ * SimGrid VMs on every node:
+ *
+ *   {"name": "small", "per_host": 8, "cores": 2, "ram": "4GiB", "naming": "{host}-vm{vm}"}
+ *
+ * VM names follow the "naming" pattern, where {host} is the node name, {node}
+ * its index in the cluster, {vm} the index of the VM on the node, {pool} and
+ * {cluster} the pool and cluster names. Patterns are split once per pool, so
+ * that naming a VM is a few appends.
+ *
+ * Shared by the loader and the topology index writer, so that both number and
+ * name the VMs the same way: VM @c vm of node @c node is VM
+ * node * per_host + vm of the pool.
+ */
+
+#ifndef VM_POOLS_HPP
+#define VM_POOLS_HPP
+
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <xbt/parse_units.hpp>
+
+struct VmPoolConfig {
+  enum class Field { TEXT, HOST, NODE, VM };
+  struct Part {
+    Field field;
+    std::string text; // For TEXT parts
+  };
+
+  std::string name;
+  int per_host   = 0;
+  int cores      = 1;
+  size_t ramsize = 0; // Bytes, 0 when not given
+  bool start     = true;
+  std::vector<Part> naming;
+
+  /** Name of VM @p vm of the node named @p hostname, of index @p node, written to @p out */
+  void vm_name(std::string& out, const std::string& hostname, std::string_view node, std::string_view vm) const
+  {
+    out.clear();
+    for (const auto& part : naming) {
+      switch (part.field) {
+        case Field::TEXT:
+          out.append(part.text);
+          break;
+        case Field::HOST:
+          out.append(hostname);
+          break;
+        case Field::NODE:
+          out.append(node);
+          break;
+        case Field::VM:
+          out.append(vm);
+          break;
+      }
+    }
+  }
+};
+
+// Split a naming pattern; {pool} and {cluster} are constant, so they are folded into the text
+inline std::vector<VmPoolConfig::Part> parse_vm_naming(const std::string& pattern, const std::string& pool,
+                                                        const std::string& cluster)
+{
+  using Field = VmPoolConfig::Field;
+  std::vector<VmPoolConfig::Part> parts;
+  auto text = [&parts](const std::string& s) {
+    if (parts.empty() || parts.back().field != Field::TEXT)
+      parts.push_back({Field::TEXT, ""});
+    parts.back().text += s;
+  };
+  bool has_host_or_node = false;
+  bool has_vm           = false;
+  size_t pos            = 0;
+  while (pos < pattern.size()) {
+    size_t open  = pattern.find('{', pos);
+    size_t close = open == std::string::npos ? std::string::npos : pattern.find('}', open);
+    if (close == std::string::npos) {
+      text(pattern.substr(pos));
+      break;
+    }
+    text(pattern.substr(pos, open - pos));
+    const std::string key = pattern.substr(open + 1, close - open - 1);
+    if (key == "host" || key == "node") {
+      parts.push_back({key == "host" ? Field::HOST : Field::NODE, ""});
+      has_host_or_node = true;
+    } else if (key == "vm") {
+      parts.push_back({Field::VM, ""});
+      has_vm = true;
+    } else if (key == "pool") {
+      text(pool);
+    } else if (key == "cluster") {
+      text(cluster);
+    } else {
+      throw std::runtime_error("Unknown placeholder {" + key + "} in naming of VM pool " + pool + " of cluster " +
+                               cluster + " (expected host, node, vm, pool or cluster)");
+    }
+    pos = close + 1;
+  }
+  if (not has_host_or_node || not has_vm)
+    throw std::runtime_error("Naming of VM pool " + pool + " of cluster " + cluster +
+                             " must contain {vm} and {host} or {node}, for VM names to be unique");
+  return parts;
+}
+
+/** The "vm_pools" of a cluster, validated; empty when it has none */
+inline std::vector<VmPoolConfig> parse_vm_pools(const nlohmann::json& cluster_config)
+{
+  std::vector<VmPoolConfig> pools;
+  if (not cluster_config.contains("vm_pools"))
+    return pools;
+  const std::string cluster = cluster_config["name"];
+  std::set<std::string> names;
+  for (const auto& pool_cfg : cluster_config["vm_pools"]) {
+    VmPoolConfig pool;
+    pool.name     = pool_cfg["name"];
+    pool.per_host = pool_cfg["per_host"];
+    pool.cores    = pool_cfg.value("cores", 1);
+    pool.start    = pool_cfg.value("start", true);
+    if (not names.insert(pool.name).second)
+      throw std::runtime_error("Duplicate VM pool " + pool.name + " in cluster " + cluster);
+    if (pool.per_host < 0 || pool.cores < 1)
+      throw std::runtime_error("VM pool " + pool.name + " of cluster " + cluster +
+                               " needs a non-negative per_host and a positive number of cores");
+    if (pool_cfg.contains("ram"))
+      pool.ramsize = static_cast<size_t>(xbt_parse_get_size(pool.name, 0, pool_cfg["ram"], "ram"));
+    pool.naming = parse_vm_naming(pool_cfg.value("naming", "{host}_{pool}{vm}"), pool.name, cluster);
+    pools.push_back(std::move(pool));
+  }
+  return pools;
+}
+
+/** Number of VMs of the pools of a cluster */
+inline size_t count_vms(const nlohmann::json& cluster_config)
+{
+  size_t total = 0;
+  if (cluster_config.contains("vm_pools"))
+    for (const auto& pool_cfg : cluster_config["vm_pools"])
+      total += cluster_config["count"].get<size_t>() * pool_cfg["per_host"].get<size_t>();
+  return total;
+}
+
+#endif
@@ -0,0 +1,198 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <stdexcept>
+#include <string>
+
+#include <xbt/parse_units.hpp>
+
+#include "interconnect.hpp"
+#include "xml_exporter.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+class XmlExporter {
+  std::ostream& out_;
+  XmlExportOptions options_;
+
+  static std::string escape(const std::string& s)
+  {
+    std::string escaped;
+    for (char c : s) {
+      switch (c) {
+        case '&':
+          escaped += "&amp;";
+          break;
+        case '<':
+          escaped += "&lt;";
+          break;
+        case '>':
+          escaped += "&gt;";
+          break;
+        case '"':
+          escaped += "&quot;";
+          break;
+        default:
+          escaped += c;
+      }
+    }
+    return escaped;
+  }
+
+  static std::string attr(const char* name, const std::string& value)
+  {
+    return std::string(" ") + name + "=\"" + escape(value) + "\"";
+  }
+
+  static void unsupported(const json& cfg, const char* key, const std::string& where)
+  {
+    if (cfg.contains(key))
+      throw std::runtime_error("'" + std::string(key) + "' in " + where + " has no XML export");
+  }
+
+  void export_storage_system(const json& storage_config, const std::string& indent)
+  {
+    const std::string name = storage_config["name"];
+    const std::string type = storage_config["type"];
+    int disk_count         = (type == "JBOD") ? storage_config["disk_count"].get<int>() : 1;
+
+    out_ << indent << "<zone" << attr("id", name) << attr("routing", "Full") << ">\n"
+         << indent << "  <host" << attr("id", name + "_server") << attr("speed", storage_config["server_speed"])
+         << ">\n";
+    for (int i = 0; i < disk_count; i++) {
+      std::string disk_name = (disk_count == 1) ? name + "_disk" : name + "_disk" + std::to_string(i);
+      out_ << indent << "    <disk" << attr("id", disk_name) << attr("read_bw", storage_config["read_bandwidth"])
+           << attr("write_bw", storage_config["write_bandwidth"]) << "/>\n";
+    }
+    out_ << indent << "  </host>\n"
+         << indent << "  <router" << attr("id", name + "_router") << "/>\n"
+         << indent << "</zone>\n";
+  }
+
+  void export_cluster(const json& cluster_config, const std::string& indent)
+  {
+    const std::string name   = cluster_config["name"];
+    int count                = cluster_config["count"];
+    const auto& node_cfg     = cluster_config["node"];
+    const auto& link_cfg     = node_cfg["private_link"];
+    const auto& loopback_cfg = node_cfg["loopback"];
+    const auto& backbone_cfg = cluster_config["backbone"];
+
+    if (cluster_config.value("rails", 1) > 1)
+      throw std::runtime_error("Multi-rail cluster " + name + " cannot be expressed in <cluster>");
+    if (node_cfg.contains("storage"))
+      out_ << indent << "<!-- node-local disks of " << escape(name) << " cannot be expressed in <cluster> -->\n";
+    out_ << indent << "<cluster" << attr("id", name) << attr("prefix", cluster_config["prefix"])
+         << attr("suffix", cluster_config["suffix"]) << attr("radical", "0-" + std::to_string(count - 1))
+         << attr("speed", node_cfg["speed"]) << attr("core", std::to_string(node_cfg["cores"].get<int>()))
+         << attr("bw", link_cfg["bandwidth"]) << attr("lat", link_cfg.value("latency", "0s"))
+         << attr("sharing_policy", options_.split_duplex ? "SPLITDUPLEX" : "SHARED");
+    if (options_.backbone)
+      out_ << attr("bb_bw", backbone_cfg["bandwidth"]) << attr("bb_lat", backbone_cfg.value("latency", "0s"));
+    if (options_.loopback)
+      out_ << attr("loopback_bw", loopback_cfg["bandwidth"])
+           << attr("loopback_lat", loopback_cfg.value("latency", "0s"));
+    out_ << attr("router_id", name + "_router") << "/>\n";
+  }
+
+  void export_links(const json& links_config, const std::string& indent)
+  {
+    for (const auto& link_cfg : links_config)
+      out_ << indent << "<link" << attr("id", link_cfg["name"]) << attr("bandwidth", link_cfg["bandwidth"])
+           << attr("latency", link_cfg.value("latency", "0s")) << "/>\n";
+  }
+
+  static LinkMetrics link_metrics(const json& facility_config, const std::string& link_name)
+  {
+    if (facility_config.contains("links"))
+      for (const auto& link_cfg : facility_config["links"])
+        if (link_cfg["name"] == link_name)
+          return {xbt_parse_get_bandwidth("", 0, link_cfg["bandwidth"], "bandwidth"),
+                  xbt_parse_get_time("", 0, link_cfg.value("latency", "0s"), "latency")};
+    throw std::runtime_error("Unknown link '" + link_name + "' in interconnect");
+  }
+
+  void export_routes(const json& routes_config, const std::string& indent)
+  {
+    for (const auto& route_cfg : routes_config) {
+      const std::string src = route_cfg["src"];
+      const std::string dst = route_cfg["dst"];
+      out_ << indent << "<zoneRoute" << attr("src", src) << attr("dst", dst) << attr("gw_src", src + "_router")
+           << attr("gw_dst", dst + "_router") << attr("symmetrical", "YES") << ">\n";
+      for (const auto& link_name : route_cfg["links"])
+        out_ << indent << "  <link_ctn" << attr("id", link_name) << "/>\n";
+      out_ << indent << "</zoneRoute>\n";
+    }
+  }
+
+  // Facility or nested zone, with its children
+  void export_zone(const json& zone_config, const std::string& indent)
+  {
+    const std::string zone_name = zone_config["name"];
+    unsupported(zone_config, "graphs", "zone " + zone_name);
+    out_ << indent << "<zone" << attr("id", zone_name) << attr("routing", zone_config.value("routing", "Full"))
+         << ">\n";
+    const std::string inner = indent + "  ";
+    if (zone_config.contains("storage_systems"))
+      for (const auto& storage_cfg : zone_config["storage_systems"])
+        export_storage_system(storage_cfg, inner);
+    if (zone_config.contains("clusters"))
+      for (const auto& cluster_cfg : zone_config["clusters"])
+        export_cluster(cluster_cfg, inner);
+    if (zone_config.contains("zones"))
+      for (const auto& child_cfg : zone_config["zones"])
+        export_zone(child_cfg, inner);
+    if (zone_config.contains("links"))
+      export_links(zone_config["links"], inner);
+    out_ << inner << "<router" << attr("id", zone_name + "_router") << "/>\n";
+    if (zone_config.contains("routes"))
+      export_routes(zone_config["routes"], inner);
+    if (zone_config.contains("interconnect")) {
+      auto metrics = [&zone_config](const std::string& name) { return link_metrics(zone_config, name); };
+      export_routes(to_routes_config(compute_interconnect_routes(zone_config, metrics)), inner);
+    }
+    out_ << indent << "</zone>\n";
+  }
+
+public:
+  XmlExporter(std::ostream& out, const XmlExportOptions& options) : out_(out), options_(options) {}
+
+  void export_platform(const json& config)
+  {
+    out_ << "<?xml version='1.0'?>\n"
+         << "<!DOCTYPE platform SYSTEM \"https://simgrid.org/simgrid.dtd\">\n"
+         << "<platform version=\"4.1\">\n";
+    if (not options_.config.empty()) {
+      out_ << "  <config>\n";
+      for (const auto& [key, value] : options_.config)
+        out_ << "    <prop" << attr("id", key) << attr("value", value) << "/>\n";
+      out_ << "  </config>\n";
+    }
+    out_ << "  <zone id=\"_world_\" routing=\"Full\">\n";
+
+    for (const auto& dc_config : config["facilities"])
+      export_zone(dc_config, "    ");
+
+    if (config.contains("storage_systems"))
+      for (const auto& storage_cfg : config["storage_systems"])
+        export_storage_system(storage_cfg, "    ");
+    if (config.contains("links"))
+      export_links(config["links"], "    ");
+    if (config.contains("routes"))
+      export_routes(config["routes"], "    ");
+
+    out_ << "  </zone>\n"
+         << "</platform>\n";
+  }
+};
+
+} // namespace
+
+void export_xml_platform(std::ostream& out, const json& config, const XmlExportOptions& options)
+{
+  XmlExporter(out, options).export_platform(config);
+}
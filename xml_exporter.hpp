@@ -0,0 +1,35 @@
+/* Copyright (c) 2026. The SWAT Team. All rights reserved.          */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * @file xml_exporter.hpp
+ * @brief SimGrid XML equivalent of a JSON platform configuration.
+ *
+ * FSMod storages and filesystems have no XML counterpart, and clusters use the
+ * <cluster> tag, which cannot carry node-local disks. Its routes are implicit,
+ * and the options select how its links are shaped, for platform_bench and
+ * bench_simulation to compare with the JSON loader.
+ */
+
+#ifndef XML_EXPORTER_HPP
+#define XML_EXPORTER_HPP
+
+#include <map>
+#include <ostream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+struct XmlExportOptions {
+  bool split_duplex = true; // SPLITDUPLEX private links (one SHARED link per node otherwise)
+  bool loopback     = true; // Loopback links of the configuration (SimGrid's default loopback otherwise)
+  bool backbone     = true; // Cluster backbones (private links only otherwise)
+  std::map<std::string, std::string> config; // SimGrid configuration items, written as a <config> block
+};
+
+/** Write the SimGrid XML platform equivalent to @p config; throws for what XML cannot express */
+void export_xml_platform(std::ostream& out, const nlohmann::json& config, const XmlExportOptions& options = {});
+
+#endif